@@ -49,25 +49,75 @@
 namespace jikoLib{
 	namespace GLLib{
 
-		class Mesh3D{
+		//position, rotation and scale shared by the mesh classes
+		class Transform3D{
 			private:
-				VBO vertex;
-				VBO normal;
-				VBO texcrd;
-				IBO index;
-				VAO v_array;
-
 				glm::vec3 pos;
 				glm::quat rot;
 				glm::vec3 scale;
 
 			public:
 
-				Mesh3D()
+				Transform3D()
 					:pos(0.0f, 0.0f, 0.0f),
 					rot(1.0f, 0.0f, 0.0f, 0.0f),
 					scale(1.0f, 1.0f, 1.0f)  {}
 
+				inline void setPos(const glm::vec3 &vec)
+				{
+					this->pos = vec;
+				}
+
+				inline const glm::vec3& getPos()
+				{
+					return this->pos;
+				}
+
+				inline void setScale(const glm::vec3 &vec)
+				{
+					this->scale = vec;
+				}
+
+				inline const glm::vec3& getScale()
+				{
+					return this->scale;
+				}
+
+				inline void rotate(const glm::vec3 &axis, GLfloat angle)
+				{
+					this->rot = glm::rotate(this->rot, angle, glm::normalize(axis));
+				}
+
+				inline void resetRot()
+				{
+					this->rot = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+				}
+
+				inline const glm::quat& getRot()
+				{
+					return this->rot;
+				}
+
+				inline glm::mat4 getModelMatrix()
+				{
+					glm::mat4 mat = glm::mat4_cast(rot);
+					glm::mat4 poyo = mat*glm::scale(glm::mat4(), scale);
+					return glm::translate(poyo, glm::inverse(glm::mat3(poyo))*pos);
+				}
+		};
+
+		class Mesh3D : public Transform3D{
+			private:
+				VBO vertex;
+				VBO normal;
+				VBO texcrd;
+				IBO index;
+				VAO v_array;
+
+			public:
+
+				Mesh3D() {}
+
 				inline const VBO& getVertex() const
 				{
 					return vertex;
@@ -144,46 +194,98 @@ namespace jikoLib{
 						index.copyData(ind, Size_Elem);
 					}
 
-				inline void setPos(const glm::vec3 &vec)
-				{
-					this->pos = vec;
-				}
+				//narrowest index width for the largest index (ex. GLuint indices of a small mesh go up as GLubyte)
+				template<typename T>
+					inline void copyIndexNarrowed(const T *ind, std::size_t Size_Elem)
+					{
+						index.copyIndexNarrowed(ind, Size_Elem);
+					}
+		};
 
-				inline const glm::vec3& getPos()
-				{
-					return this->pos;
-				}
+		//Mesh3D with all attributes in one interleaved buffer
+		template<typename Format = VertexFormatPNT>
+			class InterleavedMesh3D : public Transform3D{
+				private:
+					InterleavedBuffer<Format> vertex;
+					IBO index;
+					VAO v_array;
 
-				inline void setScale(const glm::vec3 &vec)
-				{
-					this->scale = vec;
-				}
+				public:
+					using format_type = Format;
 
-				inline const glm::vec3& getScale()
-				{
-					return this->scale;
-				}
+					InterleavedMesh3D() {}
 
-				inline void rotate(const glm::vec3 &axis, GLfloat angle)
-				{
-					this->rot = glm::rotate(this->rot, angle, glm::normalize(axis));
-				}
+					inline const InterleavedBuffer<Format>& getVertex() const
+					{
+						return vertex;
+					}
+					inline const IBO& getIndex() const
+					{
+						return index;
+					}
+					inline const VAO& getVArray() const
+					{
+						return v_array;
+					}
 
-				inline void resetRot()
-				{
-					this->rot = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
-				}
+					inline bool getIsSetArray() const
+					{
+						return vertex.getisSetArray();
+					}
 
-				inline const glm::quat& getRot()
+					inline bool getIsIndexSet() const
+					{
+						return index.getisSetArray();
+					}
+
+					//ex. copyData(numVertex, vert, norm, tex) for VertexFormatPNT
+					template<typename... Ts>
+						inline void copyData(std::size_t Size_Elem, const Ts*... arrays)
+						{
+							vertex.copyData(Size_Elem, arrays...);
+						}
+
+					template<typename Vertex>
+						inline void copyData(const Vertex* vertices, std::size_t Size_Elem)
+						{
+							vertex.copyData(vertices, Size_Elem);
+						}
+
+					template<typename T, std::size_t Size_Elem>
+						inline void copyIndex(const T (&ind)[Size_Elem])
+						{
+							index.copyData(ind);
+						}
+
+					template<typename T>
+						inline void copyIndex(const T *ind, std::size_t Size_Elem)
+						{
+							index.copyData(ind, Size_Elem);
+						}
+
+					template<typename T>
+						inline void copyIndexNarrowed(const T *ind, std::size_t Size_Elem)
+						{
+							index.copyIndexNarrowed(ind, Size_Elem);
+						}
+			};
+
+		//mesh drawn from a GeometryArena slice. copies share the slice (the arena owns the geometry)
+		class ArenaMesh3D : public Transform3D{
+			private:
+				GeometrySlice slice;
+
+			public:
+				ArenaMesh3D() {}
+				explicit ArenaMesh3D(const GeometrySlice &slice) :slice(slice) {}
+
+				inline const GeometrySlice& getSlice() const
 				{
-					return this->rot;
+					return slice;
 				}
-
-				inline glm::mat4 getModelMatrix()
+				inline void setSlice(const GeometrySlice &slice)
 				{
-					glm::mat4 mat = glm::mat4_cast(rot);
-					glm::mat4 poyo = mat*glm::scale(glm::mat4(), scale);
-					return glm::translate(poyo, glm::inverse(glm::mat3(poyo))*pos);
+					this->slice = slice;
 				}
 		};
 
@@ -263,55 +365,60 @@ namespace jikoLib{
 
 		namespace MeshSample{
 
-			class AbstractShape{
-				protected:
-					std::vector<GLfloat> vertex;
-					std::vector<GLfloat> normal;
-					std::vector<GLfloat> texcrd;
-					std::vector<GLushort> index;
-				public:
-					inline const GLfloat* getVertex()
-					{
-						return vertex.data();
-					}
+			//IndexType is the CPU-side index width. Mesh3D::copyIndexNarrowed() picks the upload width
+			template<typename IndexType = GLushort>
+				class AbstractShape{
+					static_assert(is_exist<IndexType, GLubyte, GLushort, GLuint>::value, "IBO array type must be GLushort or GLuint or GLubyte");
+					protected:
+						std::vector<GLfloat> vertex;
+						std::vector<GLfloat> normal;
+						std::vector<GLfloat> texcrd;
+						std::vector<IndexType> index;
+					public:
+						using index_type = IndexType;
+
+						inline const GLfloat* getVertex()
+						{
+							return vertex.data();
+						}
 
-					inline const GLfloat* getNormal()
-					{
-						return normal.data();
-					}
+						inline const GLfloat* getNormal()
+						{
+							return normal.data();
+						}
 
-					inline const GLfloat* getTexcrd()
-					{
-						return texcrd.data();
-					}
+						inline const GLfloat* getTexcrd()
+						{
+							return texcrd.data();
+						}
 
-					inline const GLushort* getIndex()
-					{
-						return index.data();
-					}
+						inline const IndexType* getIndex()
+						{
+							return index.data();
+						}
 
-					inline std::size_t getNumVertex()
-					{
-						return vertex.size()/3;
-					}
+						inline std::size_t getNumVertex()
+						{
+							return vertex.size()/3;
+						}
 
-					inline std::size_t getNumNormal()
-					{
-						return normal.size()/3;
-					}
+						inline std::size_t getNumNormal()
+						{
+							return normal.size()/3;
+						}
 
-					inline std::size_t getNumTexcrd()
-					{
-						return texcrd.size()/2;
-					}
+						inline std::size_t getNumTexcrd()
+						{
+							return texcrd.size()/2;
+						}
 
-					inline std::size_t getNumIndex()
-					{
-						return index.size();
-					}
-			};
+						inline std::size_t getNumIndex()
+						{
+							return index.size();
+						}
+				};
 
-			class Cube : public AbstractShape{
+			class Cube : public AbstractShape<>{
 				private:
 
 				public:
@@ -532,7 +639,7 @@ namespace jikoLib{
 
 			};
 
-			class CubeMap : public AbstractShape{
+			class CubeMap : public AbstractShape<>{
 				private:
 
 				public:
@@ -753,117 +860,90 @@ namespace jikoLib{
 
 			};
 
-			class Sphere : public AbstractShape
+			//indexed UV sphere. (SLICES+1)*(STACKS+1) shared vertices (the seam column is duplicated
+			//for texcoords), 6*SLICES*(STACKS-1) indices. GLuint so fine spheres pass 65535 vertices.
+			//upload the index with copyIndexNarrowed
+			class Sphere : public AbstractShape<GLuint>
 			{
 				private:
 				public:
 					Sphere(GLfloat radius, int SLICES, int STACKS)
 					{
-						vertex.reserve(SLICES*(STACKS-1)*18);
-						normal.reserve(SLICES*(STACKS-1)*18);
-						texcrd.reserve(SLICES*(STACKS-1)*12);
-
-						for(int i = 0; i < SLICES; i++)
+						const std::size_t num_slice = SLICES;
+						const std::size_t num_stack = STACKS;
+						const std::size_t row = num_slice+1;
+						const std::size_t num_vertex = row*(num_stack+1);
+
+						//trig tables. last entries are copies of the first so the seam and poles are exact
+						std::vector<GLfloat> cos_slice(row), sin_slice(row), u(row);
+						for(std::size_t i=0; i<num_slice; i++)
 						{
-							vertex.push_back(0);
-							vertex.push_back(0);
-							vertex.push_back(radius);
-
-							texcrd.push_back((GLfloat)i/SLICES);
-							texcrd.push_back(1.0f);
-
-							vertex.push_back(radius*sin(M_PI*(GLfloat)(1)/STACKS)*cos(2*M_PI*(GLfloat)(i)/SLICES));
-							vertex.push_back(radius*sin(M_PI*(GLfloat)(1)/STACKS)*sin(2*M_PI*(GLfloat)(i)/SLICES));
-							vertex.push_back(radius*cos(M_PI*(GLfloat)(1)/STACKS));
-
-							texcrd.push_back((GLfloat)i/SLICES);
-							texcrd.push_back(1.0f - 1.0f/STACKS);
-
-							vertex.push_back(radius*sin(M_PI*(GLfloat)(1)/STACKS)*cos(2*M_PI*(GLfloat)(i+1)/SLICES));
-							vertex.push_back(radius*sin(M_PI*(GLfloat)(1)/STACKS)*sin(2*M_PI*(GLfloat)(i+1)/SLICES));
-							vertex.push_back(radius*cos(M_PI*(GLfloat)(1)/STACKS));
-
-							texcrd.push_back((GLfloat)i/SLICES);
-							texcrd.push_back(1.0f - 1.0f/STACKS);
+							cos_slice[i] = static_cast<GLfloat>(cos(2*M_PI*i/num_slice));
+							sin_slice[i] = static_cast<GLfloat>(sin(2*M_PI*i/num_slice));
+							u[i] = static_cast<GLfloat>(i)/num_slice;
 						}
+						cos_slice[num_slice] = cos_slice[0];
+						sin_slice[num_slice] = sin_slice[0];
+						u[num_slice] = 1.0f;
 
-						for(int i=0; i<SLICES; i++)
+						std::vector<GLfloat> cos_stack(num_stack+1), sin_stack(num_stack+1);
+						for(std::size_t j=0; j<=num_stack; j++)
 						{
-							for(int j=1; j<STACKS-1; j++)
-							{
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j) / STACKS)*cos(2 * M_PI*(GLfloat)(i + 1) / SLICES));
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j) / STACKS)*sin(2 * M_PI*(GLfloat)(i + 1) / SLICES));
-								vertex.push_back(radius*cos(M_PI * (GLfloat)(j) / STACKS));
-
-								texcrd.push_back((GLfloat)(i+1)/SLICES);
-								texcrd.push_back(1.0f - (GLfloat)(j) / STACKS);
-
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j) / STACKS)*cos(2 * M_PI*(GLfloat)(i) / SLICES));
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j) / STACKS)*sin(2 * M_PI*(GLfloat)(i) / SLICES));
-								vertex.push_back(radius*cos(M_PI * (GLfloat)(j) / STACKS));
-
-								texcrd.push_back((GLfloat)(i)/SLICES);
-								texcrd.push_back(1.0f - (GLfloat)(j) / STACKS);
-
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j + 1) / STACKS)*cos(2 * M_PI*(GLfloat)(i) / SLICES));
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j + 1) / STACKS)*sin(2 * M_PI*(GLfloat)(i) / SLICES));
-								vertex.push_back(radius*cos(M_PI * (GLfloat)(j + 1) / STACKS));
-
-								texcrd.push_back((GLfloat)(i)/SLICES);
-								texcrd.push_back(1.0f - (GLfloat)(j+1) / STACKS);
-
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j) / STACKS)*cos(2 * M_PI*(GLfloat)(i + 1) / SLICES));
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j) / STACKS)*sin(2 * M_PI*(GLfloat)(i + 1) / SLICES));
-								vertex.push_back(radius*cos(M_PI * (GLfloat)(j) / STACKS));
-
-								texcrd.push_back((GLfloat)(i+1)/SLICES);
-								texcrd.push_back(1.0f - (GLfloat)(j) / STACKS);
-
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j + 1) / STACKS)*cos(2 * M_PI*(GLfloat)(i) / SLICES));
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j + 1) / STACKS)*sin(2 * M_PI*(GLfloat)(i) / SLICES));
-								vertex.push_back(radius*cos(M_PI * (GLfloat)(j + 1) / STACKS));
-
-								texcrd.push_back((GLfloat)(i)/SLICES);
-								texcrd.push_back(1.0f - (GLfloat)(j+1) / STACKS);
-
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j + 1) / STACKS)*cos(2 * M_PI*(GLfloat)(i + 1) / SLICES));
-								vertex.push_back(radius*sin(M_PI * (GLfloat)(j + 1) / STACKS)*sin(2 * M_PI*(GLfloat)(i + 1) / SLICES));
-								vertex.push_back(radius*cos(M_PI * (GLfloat)(j + 1) / STACKS));
-
-								texcrd.push_back((GLfloat)(i+1)/SLICES);
-								texcrd.push_back(1.0f - (GLfloat)(j+1) / STACKS);
-							}
+							cos_stack[j] = static_cast<GLfloat>(cos(M_PI*j/num_stack));
+							sin_stack[j] = static_cast<GLfloat>(sin(M_PI*j/num_stack));
 						}
-
-						for (int i = 0; i < SLICES; i++)
+						cos_stack[0] = 1.0f;
+						cos_stack[num_stack] = -1.0f;
+						sin_stack[0] = sin_stack[num_stack] = 0.0f;
+
+						//unit normals ring by ring, then vertex = radius*normal.
+						//the inner loops only multiply table entries, so they vectorize
+						normal.resize(num_vertex*3);
+						texcrd.resize(num_vertex*2);
+						for(std::size_t j=0; j<=num_stack; j++)
 						{
-							vertex.push_back(radius*sin(M_PI * (GLfloat)(STACKS - 1) / STACKS)*cos(2 * M_PI*(GLfloat)(i + 1) / SLICES));
-							vertex.push_back(radius*sin(M_PI * (GLfloat)(STACKS - 1) / STACKS)*sin(2 * M_PI*(GLfloat)(i + 1) / SLICES));
-							vertex.push_back(radius*cos(M_PI * (GLfloat)(STACKS - 1) / STACKS));
-
-							texcrd.push_back((GLfloat)(i+1)/SLICES);
-							texcrd.push_back(1.0f / STACKS);
-
-							vertex.push_back(radius*sin(M_PI * (GLfloat)(STACKS - 1) / STACKS)*cos(2 * M_PI*(GLfloat)(i) / SLICES));
-							vertex.push_back(radius*sin(M_PI * (GLfloat)(STACKS - 1) / STACKS)*sin(2 * M_PI*(GLfloat)(i) / SLICES));
-							vertex.push_back(radius*cos(M_PI * (GLfloat)(STACKS - 1) / STACKS));
-
-							texcrd.push_back((GLfloat)(i)/SLICES);
-							texcrd.push_back(1.0f / STACKS);
-
-							vertex.push_back(0);
-							vertex.push_back(0);
-							vertex.push_back(-radius);
-
-							texcrd.push_back((GLfloat)(i)/SLICES);
-							texcrd.push_back(0.0f);
+							GLfloat* n = normal.data() + j*row*3;
+							GLfloat* t = texcrd.data() + j*row*2;
+							const GLfloat s = sin_stack[j];
+							const GLfloat c = cos_stack[j];
+							const GLfloat v = 1.0f - static_cast<GLfloat>(j)/num_stack;
+							for(std::size_t i=0; i<row; i++)
+							{
+								n[3*i  ] = s*cos_slice[i];
+								n[3*i+1] = s*sin_slice[i];
+								n[3*i+2] = c;
+								t[2*i  ] = u[i];
+								t[2*i+1] = v;
+							}
 						}
+						vertex.resize(num_vertex*3);
+						for(std::size_t k=0; k<num_vertex*3; k++)
+							vertex[k] = radius*normal[k];
 
-						for(auto && v : vertex)
+						//two triangles per quad, one at the poles (the other one would be degenerate)
+						index.reserve(6*num_slice*((num_stack > 0) ? num_stack-1 : 0));
+						for(std::size_t j=0; j<num_stack; j++)
 						{
-							normal.push_back(v/radius);
+							for(std::size_t i=0; i<num_slice; i++)
+							{
+								const GLuint a = j*row + i;      //(j, i)
+								const GLuint b = (j+1)*row + i;  //(j+1, i)
+								const GLuint c = (j+1)*row + i+1;//(j+1, i+1)
+								const GLuint d = j*row + i+1;    //(j, i+1)
+								if(j != 0)
+								{
+									index.push_back(d);
+									index.push_back(a);
+									index.push_back(b);
+								}
+								if(j != num_stack-1)
+								{
+									index.push_back(d);
+									index.push_back(b);
+									index.push_back(c);
+								}
+							}
 						}
-
 					}
 
 			};
@@ -37,6 +37,8 @@
 #include <vector>
 #include <tuple>
 #include <functional>
+#include <memory>
+#include <unordered_map>
 #include "gl_helper.h"
 
 namespace jikoLib{
@@ -66,6 +68,44 @@ namespace jikoLib{
 		 */
 
 
+		//check compile status and print log
+		inline bool checkCompileStatus(GLuint shader_id)
+		{
+			GLint compiled, size;
+			GLsizei len;
+			char* buf = nullptr;
+			glGetShaderiv(shader_id, GL_COMPILE_STATUS, &compiled);
+			CHECK_GL_ERROR;
+
+			if(compiled == GL_FALSE)
+			{
+				//compile failed
+				std::cerr << "id " << shader_id << " Compile Failed!: " << std::endl;
+				glGetShaderiv(shader_id, GL_INFO_LOG_LENGTH, &size);
+				CHECK_GL_ERROR;
+				if(size > 0)
+				{
+					buf = new char[size];
+					glGetShaderInfoLog(shader_id, size, &len, buf);
+					CHECK_GL_ERROR;
+					std::cerr << buf;
+					delete[] buf;
+				}
+				std::cerr << std::endl;
+				return false;
+			}
+			DEBUG_OUT("shader compiled!");
+			return true;
+		}
+
+		//compile shader and print log
+		inline bool compileShader(GLuint shader_id)
+		{
+			glCompileShader(shader_id);
+			CHECK_GL_ERROR;
+			return checkCompileStatus(shader_id);
+		}
+
 		//shader
 		template<typename Shader_type, typename Allocator = GLAllocator<Alloc_Shader>>
 			class Shader
@@ -73,6 +113,8 @@ namespace jikoLib{
 				private:
 					GLuint shader_id;
 					bool is_compiled = false;
+					bool is_pending = false;
+					std::uint64_t source_hash = 0;
 					Allocator a;
 				public:
 					Shader()
@@ -84,8 +126,10 @@ namespace jikoLib{
 
 					~Shader()
 					{
-						a.destruct(shader_id);
-						CHECK_GL_ERROR;
+						if(a.destruct(shader_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						DEBUG_OUT("shader id " << shader_id << " destructed!");
 					}
 
@@ -93,42 +137,52 @@ namespace jikoLib{
 					{
 						this->shader_id = obj.shader_id;
 						this->is_compiled = obj.is_compiled;
+						this->is_pending = obj.is_pending;
+						this->source_hash = obj.source_hash;
 
 						a.copy(obj.a);
 						DEBUG_OUT("shader copied! shader_id is " << shader_id);
-						CHECK_GL_ERROR;
 					}
 
 					Shader(Shader<Shader_type, Allocator>&& obj)
 					{
 						this->shader_id = obj.shader_id;
 						this->is_compiled = obj.is_compiled;
+						this->is_pending = obj.is_pending;
+						this->source_hash = obj.source_hash;
 
 						a.move(std::move(obj.a));
 						DEBUG_OUT("shader moved! shader_id is " << shader_id);
-						CHECK_GL_ERROR;
 					}
 
 					Shader& operator=(const Shader<Shader_type, Allocator> &obj)
 					{
-						a.destruct(shader_id);
+						if(a.destruct(shader_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->shader_id = obj.shader_id;
 						this->is_compiled = obj.is_compiled;
+						this->is_pending = obj.is_pending;
+						this->source_hash = obj.source_hash;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("shader copied! shader_id is " << shader_id);
 						return *this;
 					}
 
 					Shader& operator=(Shader<Shader_type, Allocator>&& obj)
 					{
-						a.destruct(shader_id);
+						if(a.destruct(shader_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->shader_id = obj.shader_id;
 						this->is_compiled = obj.is_compiled;
+						this->is_pending = obj.is_pending;
+						this->source_hash = obj.source_hash;
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("shader moved! shader_id is " << shader_id);
 						return *this;
 					}
@@ -140,36 +194,28 @@ namespace jikoLib{
 						const int length = str.length();
 						glShaderSource(shader_id, 1, (const GLchar**)&source, &length);
 						CHECK_GL_ERROR;
-						glCompileShader(shader_id);
-						CHECK_GL_ERROR;
 
-						GLint compiled, size;
-						GLsizei len;
-						char* buf = nullptr;
-						glGetShaderiv(shader_id, GL_COMPILE_STATUS, &compiled);
-						CHECK_GL_ERROR;
+						const GLenum type = Shader_type::SHADER_TYPE;
+						source_hash = hash_fnv1a(str, hash_fnv1a(&type, sizeof(type)));
 
-						if(compiled == GL_FALSE)
+						if(ProgramBinaryCache::isEnabled())
 						{
-							//compile failed
-							std::cerr << "id " << shader_id << " Compile Failed!: " << std::endl;
-							glGetShaderiv(shader_id, GL_INFO_LOG_LENGTH, &size);
-							CHECK_GL_ERROR;
-							if(size > 0)
-							{
-								buf = new char[size];
-								glGetShaderInfoLog(shader_id, size, &len, buf);
-								CHECK_GL_ERROR;
-								std::cerr << buf;
-								delete[] buf;
-							}
-							std::cerr << std::endl;
+							//compile at link time only if the program binary cache misses
+							is_compiled = false;
+							is_pending = true;
+							return *this;
 						}
-						else
+
+						is_pending = false;
+						if(ParallelShaderCompile::isEnabled())
 						{
-							is_compiled = true;
-							DEBUG_OUT("shader compiled!");
+							//submit only. status is checked by ShaderProg at link time
+							glCompileShader(shader_id);
+							CHECK_GL_ERROR;
+							is_compiled = false;
+							return *this;
 						}
+						is_compiled = compileShader(shader_id);
 						return *this;
 					}
 
@@ -177,6 +223,112 @@ namespace jikoLib{
 					{
 						return this->shader_id;
 					}
+
+					inline std::uint64_t getSourceHash() const
+					{
+						return this->source_hash;
+					}
+
+					inline bool isPending() const
+					{
+						return this->is_pending;
+					}
+
+					//false while the compile is deferred or only submitted
+					inline bool isCompiled() const
+					{
+						return this->is_compiled;
+					}
+			};
+
+		//shader variant cache
+		//key is the preprocessed source, so the same file + define set is compiled once.
+		//returned shaders share one GL object through allocator ref-counting.
+		template<typename Shader_type, typename Allocator = GLAllocator<Alloc_Shader>>
+			class ShaderCache
+			{
+				private:
+					ShaderPreprocessor preprocessor;
+					std::unordered_map<std::string, Shader<Shader_type, Allocator>> shaders;
+					std::size_t num_hit = 0;
+					std::size_t num_miss = 0;
+
+					//a shader submitted by parallel compile is checked when it is reused
+					static bool isUsable(const Shader<Shader_type, Allocator> &shader)
+					{
+						if(shader.isCompiled() || shader.isPending())
+							return true;
+						GLint compiled = GL_FALSE;
+						glGetShaderiv(shader.getID(), GL_COMPILE_STATUS, &compiled);
+						CHECK_GL_ERROR;
+						return compiled == GL_TRUE;
+					}
+
+					Shader<Shader_type, Allocator> getProcessed(const std::string &source)
+					{
+						auto it = shaders.find(source);
+						if(it != shaders.end())
+						{
+							if(isUsable(it->second))
+							{
+								num_hit++;
+								DEBUG_OUT("shader cache hit! shader_id is " << it->second.getID());
+								return it->second;
+							}
+							shaders.erase(it);
+						}
+						num_miss++;
+						Shader<Shader_type, Allocator> shader;
+						shader << source;
+						//failed compile is not cached, so it is compiled again next time
+						if(source.empty())
+							return shader;
+						const bool deferred = shader.isPending() || ParallelShaderCompile::isEnabled();
+						if(shader.isCompiled() || deferred)
+							shaders.emplace(source, shader);
+						return shader;
+					}
+
+				public:
+					using DefineList = ShaderPreprocessor::DefineList;
+
+					inline ShaderPreprocessor& getPreprocessor()
+					{
+						return preprocessor;
+					}
+
+					//load from file
+					Shader<Shader_type, Allocator> load(const std::string &path, const DefineList &defines = DefineList())
+					{
+						return getProcessed(preprocessor.load(path, defines));
+					}
+
+					//from source string (includes are searched relative to dir)
+					Shader<Shader_type, Allocator> fromSource(const std::string &source, const DefineList &defines = DefineList(), const std::string &dir = std::string())
+					{
+						return getProcessed(preprocessor.process(source, defines, dir));
+					}
+
+					//release the references held by the cache. shaders still in use are not deleted
+					inline void clear()
+					{
+						shaders.clear();
+					}
+
+					inline std::size_t size() const
+					{
+						return shaders.size();
+					}
+
+					inline std::size_t getNumHit() const
+					{
+						return num_hit;
+					}
+
+					inline std::size_t getNumMiss() const
+					{
+						return num_miss;
+					}
 			};
 
 		//shaderprog
@@ -184,23 +336,128 @@ namespace jikoLib{
 			class ShaderProg
 			{
 				private:
+					//link state belongs to the GL program, so copies share it like reflection
+					struct LinkState
+					{
+						bool linked = false;
+						bool pending = false;
+						bool save_binary = false;
+						bool deferred_compile = false;
+						std::uint64_t source_hash = 14695981039346656037ULL;
+						//source_hash of the last link (finishLink saves the binary under it)
+						std::uint64_t binary_key = 0;
+						std::vector<GLuint> pending_shaders;
+					};
+
 					GLuint shaderprog_id;
-					bool isLinked = false;
 					Allocator a;
+					std::shared_ptr<LinkState> link;
+					std::shared_ptr<ProgramReflection> reflection;
+					std::shared_ptr<UniformTable> uniforms;
+
+					inline std::size_t getUniformIndex(const std::string &str) const
+					{
+						resolveLink();
+						auto index = uniforms->find(shaderprog_id, str);
+						if(uniforms->getLocation(index) == -1)
+						{
+							std::cerr << "uniform variable " << str << " cannot be found" << std::endl;
+							return UniformTable::npos;
+						}
+						return index;
+					}
+
+					inline bool checkHandle(const UniformHandle &handle) const
+					{
+						if(handle.program != shaderprog_id)
+						{
+							std::cerr << "uniform handle belongs to other shaderprog --did nothing" << std::endl;
+							return false;
+						}
+						if(handle.isValid() && (uniforms->getLocation(handle.index) != handle.location))
+						{
+							std::cerr << "uniform handle is out of date (relinked?) --did nothing" << std::endl;
+							return false;
+						}
+						return handle.isValid();
+					}
+
+					//check link status (blocks until link has finished)
+					void finishLink() const
+					{
+						link->pending = false;
+
+						GLint linked;
+						int size=0, len=0;
+
+						glGetProgramiv(shaderprog_id, GL_LINK_STATUS, &linked);
+						CHECK_GL_ERROR;
+						if(linked == GL_FALSE)
+						{
+							std::cerr << "id "<< shaderprog_id <<" Link Failed!: " << std::endl;
+							glGetProgramiv(shaderprog_id, GL_INFO_LOG_LENGTH, &size);
+							CHECK_GL_ERROR;
+							if(size > 0)
+							{
+								char *buf = new char[size];
+								glGetProgramInfoLog(shaderprog_id, size, &len, buf);
+								CHECK_GL_ERROR;
+								std::cerr << buf;
+								delete[] buf;
+							}
+							std::cerr << std::endl;
+
+							if(link->deferred_compile)
+							{
+								//compile status of attached shaders was not checked yet
+								GLint num_shaders = 0;
+								glGetProgramiv(shaderprog_id, GL_ATTACHED_SHADERS, &num_shaders);
+								std::vector<GLuint> shaders(num_shaders);
+								if(num_shaders > 0)
+									glGetAttachedShaders(shaderprog_id, num_shaders, nullptr, shaders.data());
+								CHECK_GL_ERROR;
+								for(auto&& id : shaders)
+									checkCompileStatus(id);
+							}
+						}
+						else
+						{
+							link->linked = true;
+							DEBUG_OUT("shader linked!");
+							if(link->save_binary)
+								ProgramBinaryCache::save(shaderprog_id, ProgramBinaryCache::getPath(link->binary_key));
+							reflection->build(shaderprog_id);
+							uniforms->build(*reflection);
+						}
+					}
+
+					//finish deferred link before the program is used
+					inline void resolveLink() const
+					{
+						if(link->pending)
+							finishLink();
+					}
+
 				public:
 					inline void bind() const
 					{
-						glUseProgram(shaderprog_id);
+						resolveLink();
+						BindState::useProgram(shaderprog_id);
 						CHECK_GL_ERROR;
 					}
 
 					inline void unbind() const
 					{
-						glUseProgram(0);
+						if(BindState::isLazyUnbind())
+							return;
+						BindState::useProgram(0);
 						CHECK_GL_ERROR;
 					}
 
 					ShaderProg()
+						:link(std::make_shared<LinkState>()),
+						reflection(std::make_shared<ProgramReflection>()),
+						uniforms(std::make_shared<UniformTable>())
 					{
 						shaderprog_id = a.construct();
 						CHECK_GL_ERROR;
@@ -209,51 +466,63 @@ namespace jikoLib{
 
 					~ShaderProg()
 					{
-						a.destruct(shaderprog_id);
-						CHECK_GL_ERROR;
+						if(a.destruct(shaderprog_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						DEBUG_OUT("shaderprog id " << shaderprog_id << " destructed!");
 					}
 
 					ShaderProg(const ShaderProg<Allocator> &obj)
 					{
 						this->shaderprog_id = obj.shaderprog_id;
-						this->isLinked = obj.isLinked;
+						this->link = obj.link;
+						this->reflection = obj.reflection;
+						this->uniforms = obj.uniforms;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("shaderprog copied! shaderprog id is " << shaderprog_id);
 					}
 
 					ShaderProg(ShaderProg<Allocator>&& obj)
 					{
 						this->shaderprog_id = obj.shaderprog_id;
-						this->isLinked = obj.isLinked;
+						this->link = std::move(obj.link);
+						this->reflection = std::move(obj.reflection);
+						this->uniforms = std::move(obj.uniforms);
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("shaderprog moved! shaderprog id is " << shaderprog_id);
 					}
 
 					ShaderProg& operator=(const ShaderProg<Allocator> &obj)
 					{
-						a.destruct(shaderprog_id);
+						if(a.destruct(shaderprog_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->shaderprog_id = obj.shaderprog_id;
-						this->isLinked = obj.isLinked;
+						this->link = obj.link;
+						this->reflection = obj.reflection;
+						this->uniforms = obj.uniforms;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("shaderprog copied! shaderprog id is " << shaderprog_id);
 						return *this;
 					}
 
 					ShaderProg& operator=(ShaderProg<Allocator>&& obj)
 					{
-						a.destruct(shaderprog_id);
+						if(a.destruct(shaderprog_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->shaderprog_id = obj.shaderprog_id;
-						this->isLinked = obj.isLinked;
+						this->link = std::move(obj.link);
+						this->reflection = std::move(obj.reflection);
+						this->uniforms = std::move(obj.uniforms);
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("shaderprog moved! shaderprog id is " << shaderprog_id);
 						return *this;
 					}
@@ -263,12 +532,22 @@ namespace jikoLib{
 						return shaderprog_id;
 					}
 
+					//key of ProgramBinaryCache (hash of sources attached since the last link)
+					inline std::uint64_t getSourceHash() const
+					{
+						return link->source_hash;
+					}
+
 					template<typename Shader_type, typename Shader_Allocator>
 						ShaderProg& operator<<(const Shader<Shader_type, Shader_Allocator> &shader)
 						//attach shader
 						{
 							glAttachShader(shaderprog_id, shader.getID());
 							CHECK_GL_ERROR;
+							const std::uint64_t shader_hash = shader.getSourceHash();
+							link->source_hash = hash_fnv1a(&shader_hash, sizeof(shader_hash), link->source_hash);
+							if(shader.isPending())
+								link->pending_shaders.push_back(shader.getID());
 							DEBUG_OUT("attach shader! shader id is "
 									<< shader.getID() 
 									<< ". shaderprog id is " 
@@ -279,37 +558,86 @@ namespace jikoLib{
 					ShaderProg& operator<<(link_these&&)
 						//link shader
 					{
-						glLinkProgram(shaderprog_id);
-						CHECK_GL_ERROR;
+						const bool use_cache = ProgramBinaryCache::isEnabled();
+						const bool parallel = ParallelShaderCompile::isEnabled();
 
-						GLint linked;
-						int size=0, len=0;
+						//next attach starts a new source set
+						link->binary_key = link->source_hash;
+						link->source_hash = 14695981039346656037ULL;
 
-						glGetProgramiv(shaderprog_id, GL_LINK_STATUS, &linked);
-						CHECK_GL_ERROR;
-						if(linked == GL_FALSE)
+						if(use_cache && ProgramBinaryCache::load(shaderprog_id, ProgramBinaryCache::getPath(link->binary_key)))
 						{
-							std::cerr << "id "<< shaderprog_id <<" Link Failed!: " << std::endl;
-							glGetProgramiv(shaderprog_id, GL_INFO_LOG_LENGTH, &size);
-							CHECK_GL_ERROR;
-							if(size > 0)
+							link->pending_shaders.clear();
+							link->pending = false;
+							link->linked = true;
+							reflection->build(shaderprog_id);
+							uniforms->build(*reflection);
+							return *this;
+						}
+
+						//cache miss (or disabled). compile deferred shaders here
+						for(auto&& id : link->pending_shaders)
+						{
+							if(parallel)
 							{
-								char *buf = new char[size];
-								glGetProgramInfoLog(shaderprog_id, size, &len, buf);
+								glCompileShader(id);
 								CHECK_GL_ERROR;
-								std::cerr << buf;
-								delete[] buf;
 							}
-							std::cerr << std::endl;
+							else
+								compileShader(id);
 						}
-						else
+						link->pending_shaders.clear();
+
+						if(use_cache)
 						{
-							isLinked = true;
-							DEBUG_OUT("shader linked!");
+							glProgramParameteri(shaderprog_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+							CHECK_GL_ERROR;
 						}
+
+						glLinkProgram(shaderprog_id);
+						CHECK_GL_ERROR;
+
+						link->linked = false;
+						link->pending = true;
+						link->save_binary = use_cache;
+						link->deferred_compile = parallel;
+						//in parallel mode, status is checked by isReady() or on first use
+						if(!parallel)
+							finishLink();
 						return *this;
 					}
 
+					//true if link has finished. never blocks if KHR_parallel_shader_compile is supported
+					bool isReady() const
+					{
+						if(!link->pending)
+							return link->linked;
+
+						if(ParallelShaderCompile::isSupported())
+						{
+							GLint completed = GL_FALSE;
+							glGetProgramiv(shaderprog_id, GL_COMPLETION_STATUS_KHR, &completed);
+							CHECK_GL_ERROR;
+							if(completed == GL_FALSE)
+								return false;
+						}
+						finishLink();
+						return link->linked;
+					}
+
+					//true while link is submitted but its status is not checked yet
+					inline bool isLinking() const
+					{
+						return link->pending;
+					}
+
+					//block until link has finished. returns link status
+					inline bool waitReady() const
+					{
+						resolveLink();
+						return link->linked;
+					}
+
 
 					//select appropriate glUniform function
 					template <typename... ArgTypes>
@@ -321,17 +649,16 @@ namespace jikoLib{
 							static_assert(is_all_same<first_type, ArgTypes...>::value, "ArgTypes must be all same");
 							static_assert(is_exist<first_type, GLint, GLfloat>::value, "ArgType must be GLint or GLfloat");
 							static_assert((1 <= sizeof...(ArgTypes))&&(sizeof...(ArgTypes) <= 4), "invalid ArgTypes Num");
-							bind();
+							auto index = getUniformIndex(str);
+							if(index == UniformTable::npos)
+								return;
 
-							auto loc = glGetUniformLocation(shaderprog_id, str.c_str());
-							CHECK_GL_ERROR;
-							if(loc == -1)
-							{
-								std::cerr << "uniform variable " << str << " cannot be found" << std::endl;
+							const first_type values[] = {args...};
+							if(!uniforms->update(index, values, sizeof(values)))
 								return;
-							}
 
-							glUniformXt<sizeof...(ArgTypes), first_type>::func(loc, args...);
+							bind();
+							glUniformXt<sizeof...(ArgTypes), first_type>::func(uniforms->getLocation(index), args...);
 							CHECK_GL_ERROR;
 							unbind();
 						}
@@ -343,19 +670,7 @@ namespace jikoLib{
 							//for glUniformXiv, glUniformXfv
 							static_assert((1 <= Dim)&&(Dim <= 4), "invalid Dim");
 							static_assert(is_exist<T,GLint, GLfloat>::value,"array type must be GLint for GLfloat");
-							bind();
-
-							auto loc = glGetUniformLocation(shaderprog_id, str.c_str());
-							CHECK_GL_ERROR;
-							if(loc == -1)
-							{
-								std::cerr << "uniform variable " << str << " cannot be found" << std::endl;
-								return;
-							}
-
-							glUniformXtv<Dim, T>::func(loc, Size_Elem, array);
-							CHECK_GL_ERROR;
-							unbind();
+							setUniformXtv(str, &(array[0][0]), Size_Elem, Dim);
 						}
 
 					template <std::size_t Dim, typename T>
@@ -364,19 +679,7 @@ namespace jikoLib{
 							//for glUniformXiv, glUniformXfv
 							static_assert((1 <= Dim)&&(Dim <= 4), "invalid Dim");
 							static_assert(is_exist<T,GLint, GLfloat>::value,"array type must be GLint for GLfloat");
-							bind();
-
-							auto loc = glGetUniformLocation(shaderprog_id, str.c_str());
-							CHECK_GL_ERROR;
-							if(loc == -1)
-							{
-								std::cerr << "uniform variable " << str << " cannot be found" << std::endl;
-								return;
-							}
-
-							glUniformXtv<Dim, T>::func(loc, 1, array);
-							CHECK_GL_ERROR;
-							unbind();
+							setUniformXtv(str, array, 1, Dim);
 						}
 
 
@@ -384,14 +687,19 @@ namespace jikoLib{
 						void setUniformXtv(const std::string &str, const T *array, std::size_t Size_Elem, std::size_t Dim = 1)
 						{
 							static_assert(is_exist<T,GLint, GLfloat>::value,"array type must be GLint for GLfloat");
-							bind();
-							auto loc = glGetUniformLocation(shaderprog_id, str.c_str());
-							CHECK_GL_ERROR;
-							if(loc == -1)
+							if((Dim < 1)||(4 < Dim))
 							{
-								std::cerr << "uniform variable " << str << " cannot be found" << std::endl;
+								std::cerr << "invalid Dim Number --did nothing." << std::endl;
 								return;
 							}
+							auto index = getUniformIndex(str);
+							if(index == UniformTable::npos)
+								return;
+							if(!uniforms->update(index, array, Size_Elem*Dim*sizeof(T)))
+								return;
+
+							auto loc = uniforms->getLocation(index);
+							bind();
 							switch (Dim) {
 								case 1:
 									glUniformXtv<1, T>::func(loc, Size_Elem, array);
@@ -405,10 +713,8 @@ namespace jikoLib{
 								case 4:
 									glUniformXtv<4, T>::func(loc, Size_Elem, array);
 									break;
-								default:
-									std::cerr << "invalid Dim Number --did nothing." << std::endl;
-									break;
 							}
+							CHECK_GL_ERROR;
 							unbind();
 
 						}
@@ -418,17 +724,7 @@ namespace jikoLib{
 						{
 							static_assert(is_exist<T, GLfloat>::value, "array must be GLfloat.");
 							static_assert((2 <= Dim)&&(Dim <= 4), "invalid Dim");
-
-							bind();
-							auto loc = glGetUniformLocation(shaderprog_id, str.c_str());
-							CHECK_GL_ERROR;
-							if(loc == -1)
-							{
-								std::cerr << "uniform variable " << str << " cannot be found" << std::endl;
-								return;
-							}
-							glUniformMatrixXtv<Dim, T>::func(loc, Size_Elem, GL_FALSE, array);
-							unbind();
+							setUniformMatrixXtv(str, &(array[0][0][0]), Size_Elem, Dim);
 						}
 
 					template<std::size_t Dim, typename T>
@@ -436,31 +732,26 @@ namespace jikoLib{
 						{
 							static_assert(is_exist<T, GLfloat>::value, "array must be GLfloat.");
 							static_assert((2 <= Dim)&&(Dim <= 4), "invalid Dim");
-
-							bind();
-							auto loc = glGetUniformLocation(shaderprog_id, str.c_str());
-							CHECK_GL_ERROR;
-							if(loc == -1)
-							{
-								std::cerr << "uniform variable " << str << " cannot be found" << std::endl;
-								return;
-							}
-							glUniformMatrixXtv<Dim, T>::func(loc, 1, GL_FALSE, array);
-							unbind();
+							setUniformMatrixXtv(str, &(array[0][0]), 1, Dim);
 						}
 
 					template<typename T>
 						void setUniformMatrixXtv(const std::string &str, const T *array, std::size_t Size_Elem, std::size_t Dim)
 						{
 							static_assert(is_exist<T, GLfloat>::value, "array must be GLfloat.");
-							bind();
-							auto loc = glGetUniformLocation(shaderprog_id, str.c_str());
-							CHECK_GL_ERROR;
-							if(loc == -1)
+							if((Dim < 2)||(4 < Dim))
 							{
-								std::cerr << "uniform variable " << str << " cannot be found" << std::endl;
+								std::cerr << "invalid Dim Number --did nothing." << std::endl;
 								return;
 							}
+							auto index = getUniformIndex(str);
+							if(index == UniformTable::npos)
+								return;
+							if(!uniforms->update(index, array, Size_Elem*Dim*Dim*sizeof(T)))
+								return;
+
+							auto loc = uniforms->getLocation(index);
+							bind();
 							switch(Dim)
 							{
 								case 2:
@@ -472,27 +763,400 @@ namespace jikoLib{
 								case 4:
 									glUniformMatrixXtv<4, T>::func(loc, Size_Elem, GL_FALSE, array);
 									break;
-								default:
-									std::cerr << "invalid Dim Number --did nothing." << std::endl;
-									break;
 							}
+							CHECK_GL_ERROR;
 							unbind();
 						}
 
-			};
+					//uniform block
 
+					inline const UniformBlockInfo* findUniformBlock(const std::string &str) const
+					{
+						resolveLink();
+						auto info = reflection->findUniformBlock(str);
+						if(info == nullptr)
+						{
+							std::cerr << "uniform block " << str << " cannot be found" << std::endl;
+						}
+						return info;
+					}
 
-		//vertexbuffer
-		template<typename TargetType, typename UsageType, typename Allocator = GLAllocator<Alloc_VertexBuffer>>
-			class VertexBuffer
-			{
-				private:
-					GLuint buffer_id;
+					inline GLint getUniformBlockSize(const std::string &str) const
+					{
+						auto info = findUniformBlock(str);
+						return (info != nullptr) ? info->data_size : 0;
+					}
 
-					bool isSetArray = false; 
-					GLenum ArrayEnum;
+					void setUniformBlockBinding(const std::string &str, GLuint binding)
+					{
+						auto info = findUniformBlock(str);
+						if(info == nullptr)
+							return;
+						if(info->binding == static_cast<GLint>(binding))
+							return;
+						glUniformBlockBinding(shaderprog_id, info->index, binding);
+						CHECK_GL_ERROR;
+						reflection->setUniformBlockBinding(info->index, binding);
+						DEBUG_OUT("uniform block " << str << " -> binding " << binding << ". shaderprog id is " << shaderprog_id);
+					}
+
+					//attribute
+
+					inline GLint getAttribLocation(const std::string &str) const
+					{
+						resolveLink();
+						auto info = reflection->findAttrib(str);
+						if(info == nullptr)
+						{
+							std::cerr << "attribute variable " << str << " cannot be found" << std::endl;
+							return -1;
+						}
+						return info->location;
+					}
+
+					inline const ProgramReflection& getReflection() const
+					{
+						resolveLink();
+						return *reflection;
+					}
+
+					//uniform handle (look up once, reuse every frame)
+
+					inline UniformHandle getUniformHandle(const std::string &str) const
+					{
+						UniformHandle handle;
+						handle.program = shaderprog_id;
+						handle.index = getUniformIndex(str);
+						handle.location = uniforms->getLocation(handle.index);
+						return handle;
+					}
+
+					//glProgramUniform* needs GL 4.1 or ARB_separate_shader_objects
+					static inline bool isProgramUniformSupported()
+					{
+						return GLEW_ARB_separate_shader_objects || GLEW_VERSION_4_1;
+					}
+
+					//set uniform through handle. no lookup, no bind/unbind (glProgramUniform).
+					//without glProgramUniform the program is bound and glUniform is used instead
+
+					template <typename... ArgTypes>
+						void setUniformXt(const UniformHandle &handle, ArgTypes... args)
+						{
+							using first_type = typename std::tuple_element<0, std::tuple<ArgTypes...>>::type;
+
+							static_assert(is_all_same<first_type, ArgTypes...>::value, "ArgTypes must be all same");
+							static_assert(is_exist<first_type, GLint, GLfloat>::value, "ArgType must be GLint or GLfloat");
+							static_assert((1 <= sizeof...(ArgTypes))&&(sizeof...(ArgTypes) <= 4), "invalid ArgTypes Num");
+							if(!checkHandle(handle))
+								return;
+
+							const first_type values[] = {args...};
+							if(!uniforms->update(handle.index, values, sizeof(values)))
+								return;
+
+							if(isProgramUniformSupported())
+							{
+								glProgramUniformXt<sizeof...(ArgTypes), first_type>::func(shaderprog_id, handle.location, args...);
+								CHECK_GL_ERROR;
+								return;
+							}
+							bind();
+							glUniformXt<sizeof...(ArgTypes), first_type>::func(handle.location, args...);
+							CHECK_GL_ERROR;
+							unbind();
+						}
+
+					template <std::size_t Size_Elem, std::size_t Dim, typename T>
+						void setUniformXtv(const UniformHandle &handle, const T (&array)[Size_Elem][Dim])
+						{
+							static_assert((1 <= Dim)&&(Dim <= 4), "invalid Dim");
+							static_assert(is_exist<T,GLint, GLfloat>::value,"array type must be GLint for GLfloat");
+							setUniformXtv(handle, &(array[0][0]), Size_Elem, Dim);
+						}
+
+					template <std::size_t Dim, typename T>
+						void setUniformXtv(const UniformHandle &handle, const T (&array)[Dim])
+						{
+							static_assert((1 <= Dim)&&(Dim <= 4), "invalid Dim");
+							static_assert(is_exist<T,GLint, GLfloat>::value,"array type must be GLint for GLfloat");
+							setUniformXtv(handle, array, 1, Dim);
+						}
+
+					template<typename T>
+						void setUniformXtv(const UniformHandle &handle, const T *array, std::size_t Size_Elem, std::size_t Dim = 1)
+						{
+							static_assert(is_exist<T,GLint, GLfloat>::value,"array type must be GLint for GLfloat");
+							if((Dim < 1)||(4 < Dim))
+							{
+								std::cerr << "invalid Dim Number --did nothing." << std::endl;
+								return;
+							}
+							if(!checkHandle(handle))
+								return;
+							if(!uniforms->update(handle.index, array, Size_Elem*Dim*sizeof(T)))
+								return;
+
+							const bool direct = isProgramUniformSupported();
+							if(!direct)
+								bind();
+							switch (Dim) {
+								case 1:
+									if(direct)
+										glProgramUniformXtv<1, T>::func(shaderprog_id, handle.location, Size_Elem, array);
+									else
+										glUniformXtv<1, T>::func(handle.location, Size_Elem, array);
+									break;
+								case 2:
+									if(direct)
+										glProgramUniformXtv<2, T>::func(shaderprog_id, handle.location, Size_Elem, array);
+									else
+										glUniformXtv<2, T>::func(handle.location, Size_Elem, array);
+									break;
+								case 3:
+									if(direct)
+										glProgramUniformXtv<3, T>::func(shaderprog_id, handle.location, Size_Elem, array);
+									else
+										glUniformXtv<3, T>::func(handle.location, Size_Elem, array);
+									break;
+								case 4:
+									if(direct)
+										glProgramUniformXtv<4, T>::func(shaderprog_id, handle.location, Size_Elem, array);
+									else
+										glUniformXtv<4, T>::func(handle.location, Size_Elem, array);
+									break;
+							}
+							CHECK_GL_ERROR;
+							if(!direct)
+								unbind();
+						}
+
+					template<std::size_t Size_Elem, std::size_t Dim, typename T>
+						void setUniformMatrixXtv(const UniformHandle &handle, const T (&array)[Size_Elem][Dim][Dim])
+						{
+							static_assert(is_exist<T, GLfloat>::value, "array must be GLfloat.");
+							static_assert((2 <= Dim)&&(Dim <= 4), "invalid Dim");
+							setUniformMatrixXtv(handle, &(array[0][0][0]), Size_Elem, Dim);
+						}
+
+					template<std::size_t Dim, typename T>
+						void setUniformMatrixXtv(const UniformHandle &handle, const T (&array)[Dim][Dim])
+						{
+							static_assert(is_exist<T, GLfloat>::value, "array must be GLfloat.");
+							static_assert((2 <= Dim)&&(Dim <= 4), "invalid Dim");
+							setUniformMatrixXtv(handle, &(array[0][0]), 1, Dim);
+						}
+
+					template<typename T>
+						void setUniformMatrixXtv(const UniformHandle &handle, const T *array, std::size_t Size_Elem, std::size_t Dim)
+						{
+							static_assert(is_exist<T, GLfloat>::value, "array must be GLfloat.");
+							if((Dim < 2)||(4 < Dim))
+							{
+								std::cerr << "invalid Dim Number --did nothing." << std::endl;
+								return;
+							}
+							if(!checkHandle(handle))
+								return;
+							if(!uniforms->update(handle.index, array, Size_Elem*Dim*Dim*sizeof(T)))
+								return;
+
+							const bool direct = isProgramUniformSupported();
+							if(!direct)
+								bind();
+							switch(Dim)
+							{
+								case 2:
+									if(direct)
+										glProgramUniformMatrixXtv<2, T>::func(shaderprog_id, handle.location, Size_Elem, GL_FALSE, array);
+									else
+										glUniformMatrixXtv<2, T>::func(handle.location, Size_Elem, GL_FALSE, array);
+									break;
+								case 3:
+									if(direct)
+										glProgramUniformMatrixXtv<3, T>::func(shaderprog_id, handle.location, Size_Elem, GL_FALSE, array);
+									else
+										glUniformMatrixXtv<3, T>::func(handle.location, Size_Elem, GL_FALSE, array);
+									break;
+								case 4:
+									if(direct)
+										glProgramUniformMatrixXtv<4, T>::func(shaderprog_id, handle.location, Size_Elem, GL_FALSE, array);
+									else
+										glUniformMatrixXtv<4, T>::func(handle.location, Size_Elem, GL_FALSE, array);
+									break;
+							}
+							CHECK_GL_ERROR;
+							if(!direct)
+								unbind();
+						}
+
+					//upload counter (skipped: same value as last time)
+
+					inline std::size_t getNumUniformIssued() const
+					{
+						return uniforms->getNumIssued();
+					}
+
+					inline std::size_t getNumUniformSkipped() const
+					{
+						return uniforms->getNumSkipped();
+					}
+
+					inline void resetUniformCounter()
+					{
+						uniforms->resetCounter();
+					}
+
+			};
+
+
+		//shader hot reload
+		//sources are watched and rebuilt through the deferred compile path. the new program
+		//replaces the current one in update() once it is linked. on failure the current one stays.
+		template<typename Allocator = GLAllocator<Alloc_ShaderProg>>
+			class ShaderReloader
+			{
+				public:
+					using DefineList = ShaderPreprocessor::DefineList;
+
+				private:
+					struct Stage
+					{
+						std::string path;
+						DefineList defines;
+						std::function<void(ShaderProg<Allocator>&, const std::string&)> attach;
+					};
+
+					ShaderPreprocessor preprocessor;
+					FileWatcher watcher;
+					std::vector<Stage> stages;
+					ShaderProg<Allocator> current;
+					std::unique_ptr<ShaderProg<Allocator>> pending;
+					std::function<void(ShaderProg<Allocator>&)> on_reload;
+
+					//attach all stages and submit link. included files are added to the watch list
+					void submit(ShaderProg<Allocator> &prog)
+					{
+						for(auto&& stage : stages)
+						{
+							std::vector<std::string> included;
+							stage.attach(prog, preprocessor.load(stage.path, stage.defines, &included));
+							for(auto&& path : included)
+								watcher.watch(path);
+						}
+						prog << link_these();
+					}
+
+				public:
+					inline ShaderPreprocessor& getPreprocessor()
+					{
+						return preprocessor;
+					}
+
+					template<typename Shader_type>
+						void addStage(const std::string &path, const DefineList &defines = DefineList())
+						{
+							stages.push_back(Stage{path, defines,
+									[](ShaderProg<Allocator> &prog, const std::string &source)
+									{
+										Shader<Shader_type> shader;
+										shader << source;
+										prog << shader;
+									}});
+							watcher.watch(path);
+						}
+
+					//called after a new program is swapped in (refresh uniform handles, uniforms, etc.)
+					inline void setOnReload(const std::function<void(ShaderProg<Allocator>&)> &func)
+					{
+						on_reload = func;
+					}
+
+					//first build. blocks until linked
+					bool build()
+					{
+						ShaderProg<Allocator> prog;
+						submit(prog);
+						if(!prog.waitReady())
+							return false;
+						current = std::move(prog);
+						return true;
+					}
+
+					//call once per frame. returns true if the program was replaced
+					bool update()
+					{
+						if(pending)
+						{
+							if(pending->isReady())
+							{
+								current = std::move(*pending);
+								pending.reset();
+								DEBUG_OUT("shader reloaded! shaderprog id is " << current.getID());
+								if(on_reload)
+									on_reload(current);
+								return true;
+							}
+							if(!pending->isLinking())
+							{
+								std::cerr << "shader reload failed. keep current program" << std::endl;
+								pending.reset();
+							}
+							return false;
+						}
+
+						if(watcher.poll().empty())
+							return false;
+
+						ParallelShaderCompile::Scope scope;
+						pending.reset(new ShaderProg<Allocator>());
+						submit(*pending);
+						return false;
+					}
+
+					inline ShaderProg<Allocator>& get()
+					{
+						return current;
+					}
+
+					inline const ShaderProg<Allocator>& get() const
+					{
+						return current;
+					}
+				};
+
+
+		//buffer to buffer copy on the GPU (GL3.1 or ARB_copy_buffer)
+		inline void copyBufferSubData(GLuint read_buffer, GLuint write_buffer, GLintptr read_offset, GLintptr write_offset, GLsizeiptr size)
+		{
+			if(size == 0)
+				return;
+			if(USE_DSA)
+			{
+				glCopyNamedBufferSubData(read_buffer, write_buffer, read_offset, write_offset, size);
+				CHECK_GL_ERROR;
+				return;
+			}
+			//the copy targets are not used for drawing, so they are left bound
+			BindState::bindBuffer(GL_COPY_READ_BUFFER, read_buffer);
+			BindState::bindBuffer(GL_COPY_WRITE_BUFFER, write_buffer);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, read_offset, write_offset, size);
+			CHECK_GL_ERROR;
+		}
+
+		//vertexbuffer
+		template<typename TargetType, typename UsageType, typename Allocator = DefaultAllocator<Alloc_VertexBuffer>>
+			class VertexBuffer
+			{
+				private:
+					GLuint buffer_id;
+
+					bool isSetArray = false; 
+					GLenum ArrayEnum;
 					std::size_t Size_Elem;
 					std::size_t Dim;
+					std::size_t Capacity_Elem = 0;
+					GLboolean Normalized = GL_FALSE;
 
 					Allocator a;
 
@@ -500,11 +1164,82 @@ namespace jikoLib{
 						inline void setSizeElem_Dim_Type(std::size_t Size_Elem, std::size_t Dim)
 						{
 							this->Size_Elem = Size_Elem;
+							this->Capacity_Elem = Size_Elem;
 							this->Dim = Dim;
 							this->ArrayEnum = getEnum<Type>::value;
+							this->Normalized = GL_FALSE;
 							isSetArray = true;
 						}
 
+					//empty store for Capacity_Elem elements in the element format of src (nothing is drawn yet)
+					template<typename SrcTarget, typename SrcUsage, typename SrcAlloc>
+						inline void allocateLike(const VertexBuffer<SrcTarget, SrcUsage, SrcAlloc> &src, std::size_t Capacity_Elem)
+						{
+							bufferData(Capacity_Elem*getAttribSize(src.getArrayEnum(), src.getDim()), NULL);
+							this->Size_Elem = 0;
+							this->Capacity_Elem = Capacity_Elem;
+							this->Dim = src.getDim();
+							this->ArrayEnum = src.getArrayEnum();
+							this->Normalized = src.getNormalized();
+							isSetArray = true;
+						}
+
+					//indices converted to IndexType (no conversion if T is IndexType)
+					template<typename IndexType, typename T>
+						inline void copyIndexAs(const T* array, std::size_t Size_Elem)
+						{
+							if(std::is_same<IndexType, T>::value)
+							{
+								copyData(reinterpret_cast<const IndexType*>(array), Size_Elem);
+								return;
+							}
+							std::vector<IndexType> converted(array, array+Size_Elem);
+							copyData(converted.data(), Size_Elem);
+						}
+
+					//bind to upload data. element array binding is vertex array state,
+					//so never upload into a vertex array left bound by lazy unbind
+					inline void bindForUpdate() const
+					{
+						if(std::is_same<TargetType, ElementArrayBuffer>::value && BindState::isLazyUnbind())
+							BindState::bindVertexArray(0);
+						bind();
+					}
+
+					//glBufferData (or glNamedBufferData)
+					inline void bufferData(GLsizeiptr size, const GLvoid* data)
+					{
+						MemoryStats::allocate<Alloc_VertexBuffer>(buffer_id, size);
+						if(data != nullptr)
+							MemoryStats::upload(size);
+						if(USE_DSA)
+						{
+							glNamedBufferData(buffer_id, size, data, UsageType::BUFFER_USAGE);
+							CHECK_GL_ERROR;
+							return;
+						}
+						bindForUpdate();
+						glBufferData(TargetType::BUFFER_TARGET, size, data, UsageType::BUFFER_USAGE);
+						CHECK_GL_ERROR;
+						unbind();
+					}
+
+					//glBufferSubData (or glNamedBufferSubData)
+					inline void bufferSubData(GLintptr offset, GLsizeiptr size, const GLvoid* data)
+					{
+						MemoryStats::upload(size);
+						if(USE_DSA)
+						{
+							glNamedBufferSubData(buffer_id, offset, size, data);
+							CHECK_GL_ERROR;
+							return;
+						}
+						bindForUpdate();
+						glBufferSubData(TargetType::BUFFER_TARGET, offset, size, data);
+						CHECK_GL_ERROR;
+						unbind();
+					}
+
 				public:
 
 					inline bool getisSetArray() const
@@ -523,16 +1258,31 @@ namespace jikoLib{
 					{
 						return Dim;
 					}
+					inline std::size_t getCapacityElem() const
+					{
+						return Capacity_Elem;
+					}
+					inline GLboolean getNormalized() const
+					{
+						return Normalized;
+					}
+					//bytes of one element
+					inline std::size_t getElemSize() const
+					{
+						return getAttribSize(ArrayEnum, Dim);
+					}
 
 					inline void bind() const
 					{
-						glBindBuffer(TargetType::BUFFER_TARGET, buffer_id);
+						BindState::bindBuffer(TargetType::BUFFER_TARGET, buffer_id);
 						CHECK_GL_ERROR;
 					}
 
 					inline void unbind() const
 					{
-						glBindBuffer(TargetType::BUFFER_TARGET, 0);
+						if(BindState::isLazyUnbind())
+							return;
+						BindState::bindBuffer(TargetType::BUFFER_TARGET, 0);
 						CHECK_GL_ERROR;
 					}
 
@@ -540,15 +1290,21 @@ namespace jikoLib{
 					{
 						buffer_id = a.construct();
 						CHECK_GL_ERROR;
-						bind();
+						//glGen* name becomes an object on first bind. glCreate* does not need it
+						if(!USE_DSA)
+						{
+							bindForUpdate();
+							unbind();
+						}
 						DEBUG_OUT("vbuffer created! id is " << buffer_id);
-						unbind();
 					}
 
 					~VertexBuffer()
 					{
-						a.destruct(buffer_id);
-						CHECK_GL_ERROR;
+						if(a.destruct(buffer_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						DEBUG_OUT("vbuffer id " << buffer_id << " destructed!");
 					}
 
@@ -559,9 +1315,10 @@ namespace jikoLib{
 						this->ArrayEnum = obj.ArrayEnum;
 						this->Size_Elem = obj.Size_Elem;
 						this->Dim = obj.Dim;
+						this->Capacity_Elem = obj.Capacity_Elem;
+						this->Normalized = obj.Normalized;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("vbuffer copied! id is " << buffer_id);
 					}
 
@@ -572,38 +1329,47 @@ namespace jikoLib{
 						this->ArrayEnum = obj.ArrayEnum;
 						this->Size_Elem = obj.Size_Elem;
 						this->Dim = obj.Dim;
+						this->Capacity_Elem = obj.Capacity_Elem;
+						this->Normalized = obj.Normalized;
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("vbuffer moved! id is " << buffer_id);
 					}
 
 					VertexBuffer& operator=(const VertexBuffer<TargetType, UsageType, Allocator> &obj)
 					{
-						a.destruct(buffer_id);
+						if(a.destruct(buffer_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->buffer_id = obj.buffer_id;
 						this->isSetArray = obj.isSetArray;
 						this->ArrayEnum = obj.ArrayEnum;
 						this->Size_Elem = obj.Size_Elem;
 						this->Dim = obj.Dim;
+						this->Capacity_Elem = obj.Capacity_Elem;
+						this->Normalized = obj.Normalized;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("vbuffer copied! id is " << buffer_id);
 						return *this;
 					}
 
 					VertexBuffer& operator=(VertexBuffer<TargetType, UsageType, Allocator>&& obj)
 					{
-						a.destruct(buffer_id);
+						if(a.destruct(buffer_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->buffer_id = obj.buffer_id;
 						this->isSetArray = obj.isSetArray;
 						this->ArrayEnum = obj.ArrayEnum;
 						this->Size_Elem = obj.Size_Elem;
 						this->Dim = obj.Dim;
+						this->Capacity_Elem = obj.Capacity_Elem;
+						this->Normalized = obj.Normalized;
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("vbuffer moved! id is " << buffer_id);
 						return *this;
 					}
@@ -613,6 +1379,12 @@ namespace jikoLib{
 						return buffer_id;
 					}
 
+					//name shown in MemoryStats::getLabelBytes()
+					inline void setLabel(const std::string &label) const
+					{
+						MemoryStats::setLabel<Alloc_VertexBuffer>(buffer_id, label);
+					}
+
 
 					template<typename T>
 						void copyData(const T* array, std::size_t Size_Elem, std::size_t Dim = 1)
@@ -620,12 +1392,9 @@ namespace jikoLib{
 							static_assert( is_exist<T, GLbyte, GLubyte, GLshort, GLushort, GLint, GLuint, GLfloat, GLdouble>::value, "Invalid type" );
 							static_assert((!std::is_same<TargetType,ElementArrayBuffer>::value)||((std::is_same<TargetType,ElementArrayBuffer>::value)&&(is_exist<T,GLubyte,GLushort,GLuint>::value)),
 									"IBO array type must be GLushort or GLuint or GLubyte");
-							bind();
-							glBufferData(TargetType::BUFFER_TARGET, Size_Elem*Dim*sizeof(T), array, UsageType::BUFFER_USAGE);
-							CHECK_GL_ERROR;
+							bufferData(Size_Elem*Dim*sizeof(T), array);
 							DEBUG_OUT("allocate "<< Size_Elem*Dim*sizeof(T) <<" B success! buffer id is " << buffer_id);
 							setSizeElem_Dim_Type<T>(Size_Elem, Dim);
-							unbind();
 						}
 
 					template<typename T,std::size_t Size_Elem, std::size_t Dim>
@@ -640,283 +1409,690 @@ namespace jikoLib{
 							copyData(&(array[0][0]), Size_Elem, Dim);
 						}
 
-					template<typename T, std::size_t Size_Elem>
-						inline void copyData(const T (&array)[Size_Elem])
+					template<typename T, std::size_t Size_Elem>
+						inline void copyData(const T (&array)[Size_Elem])
+						{
+							static_assert( is_exist<T, GLbyte, GLubyte, GLshort, GLushort, GLint, GLuint, GLfloat, GLdouble>::value, "Invalid type" );
+							static_assert( (Size_Elem != 0), "Zero Elem" );
+							static_assert((!std::is_same<TargetType,ElementArrayBuffer>::value)||((std::is_same<TargetType,ElementArrayBuffer>::value)&&(is_exist<T,GLubyte,GLushort,GLuint>::value)),
+									"IBO array type must be GLushort or GLuint or GLubyte");
+
+							copyData(&(array[0]), Size_Elem, 1);
+						}
+
+					//GLfloat array stored as AttribType (ex. Attrib<HalfFloat,3>, Attrib<Int2_10_10_10_Rev,3,true>).
+					//array holds Size_Elem*AttribType::SOURCE_DIM values. getArrayEnum()/getDim() give the stored format
+					template<typename AttribType>
+						void copyEncoded(const GLfloat* array, std::size_t Size_Elem)
+						{
+							static_assert(!std::is_same<TargetType,ElementArrayBuffer>::value, "IBO can not be encoded");
+							std::vector<typename AttribType::value_type> encoded(Size_Elem*AttribType::NUM_VALUE);
+							AttribType::encode(array, encoded.data(), Size_Elem);
+							bufferData(Size_Elem*AttribType::SIZE, encoded.data());
+							DEBUG_OUT("allocate "<< Size_Elem*AttribType::SIZE <<" B (encoded) success! buffer id is " << buffer_id);
+							this->Size_Elem = Size_Elem;
+							this->Capacity_Elem = Size_Elem;
+							this->Dim = AttribType::DIM;
+							this->ArrayEnum = AttribType::TYPE;
+							this->Normalized = AttribType::NORMALIZED;
+							isSetArray = true;
+						}
+
+					//index array in the narrowest of GLubyte/GLushort/GLuint that holds its largest index.
+					//T may be any integer type. draw() picks up the width from getArrayEnum()
+					template<typename T>
+						void copyIndexNarrowed(const T* array, std::size_t Size_Elem)
+						{
+							static_assert(std::is_same<TargetType,ElementArrayBuffer>::value, "copyIndexNarrowed is for IBO");
+							static_assert(std::is_integral<T>::value, "index must be integer");
+							std::size_t max_index = 0;
+							for(std::size_t i=0; i<Size_Elem; i++)
+								max_index = std::max(max_index, static_cast<std::size_t>(array[i]));
+							switch(getIndexEnum(max_index))
+							{
+								case GL_UNSIGNED_BYTE:
+									copyIndexAs<GLubyte>(array, Size_Elem);
+									break;
+								case GL_UNSIGNED_SHORT:
+									copyIndexAs<GLushort>(array, Size_Elem);
+									break;
+								default:
+									copyIndexAs<GLuint>(array, Size_Elem);
+									break;
+							}
+						}
+
+					template<typename T>
+						inline void copyIndexNarrowed(const std::vector<T> &array)
+						{
+							copyIndexNarrowed(array.data(), array.size());
+						}
+
+					//store for Capacity_Elem elements without data. the first Size_Elem elements are drawn
+					template<typename T>
+						void allocate(std::size_t Capacity_Elem, std::size_t Dim = 1, std::size_t Size_Elem = 0)
+						{
+							static_assert( is_exist<T, GLbyte, GLubyte, GLshort, GLushort, GLint, GLuint, GLfloat, GLdouble>::value, "Invalid type" );
+							static_assert((!std::is_same<TargetType,ElementArrayBuffer>::value)||((std::is_same<TargetType,ElementArrayBuffer>::value)&&(is_exist<T,GLubyte,GLushort,GLuint>::value)),
+									"IBO array type must be GLushort or GLuint or GLubyte");
+							bufferData(Capacity_Elem*Dim*sizeof(T), NULL);
+							DEBUG_OUT("allocate "<< Capacity_Elem*Dim*sizeof(T) <<" B success! buffer id is " << buffer_id);
+							setSizeElem_Dim_Type<T>(std::min(Size_Elem, Capacity_Elem), Dim);
+							this->Capacity_Elem = Capacity_Elem;
+						}
+
+					//overwrite elements [offset, offset+Size_Elem) without reallocating the store
+					//(writing past the drawn size extends it, up to the capacity)
+					template<typename T>
+						void subData(std::size_t offset, const T* array, std::size_t Size_Elem)
+						{
+							if(!isSetArray)
+							{
+								std::cerr << "Array is not set! --did nothing" << std::endl;
+								return;
+							}
+							if(getEnum<T>::value != ArrayEnum)
+							{
+								std::cerr << "type of subData is not same as buffer --did nothing" << std::endl;
+								return;
+							}
+							if(offset+Size_Elem > Capacity_Elem)
+							{
+								std::cerr << "subData is out of range --did nothing" << std::endl;
+								return;
+							}
+							bufferSubData(offset*Dim*sizeof(T), Size_Elem*Dim*sizeof(T), array);
+							this->Size_Elem = std::max(this->Size_Elem, offset+Size_Elem);
+						}
+
+					//per-frame data (orphaning). the old store is detached with glBufferData(NULL) and
+					//refilled with glBufferSubData, so the CPU never waits for draws still reading it.
+					//the store keeps its capacity; a larger array reallocates like copyData.
+					template<typename T>
+						void streamData(const T* array, std::size_t Size_Elem, std::size_t Dim = 1)
+						{
+							if((!isSetArray)||(getEnum<T>::value != ArrayEnum)||(this->Dim != Dim)||(Size_Elem > Capacity_Elem))
+							{
+								copyData(array, Size_Elem, Dim);
+								return;
+							}
+							bufferData(Capacity_Elem*Dim*sizeof(T), NULL);
+							bufferSubData(0, Size_Elem*Dim*sizeof(T), array);
+							this->Size_Elem = Size_Elem;
+						}
+
+					//same as streamData, through glMapBufferRange(GL_MAP_INVALIDATE_BUFFER_BIT)
+					template<typename T>
+						void streamDataMapped(const T* array, std::size_t Size_Elem, std::size_t Dim = 1)
+						{
+							if((!isSetArray)||(getEnum<T>::value != ArrayEnum)||(this->Dim != Dim)||(Size_Elem > Capacity_Elem))
+							{
+								copyData(array, Size_Elem, Dim);
+								return;
+							}
+							const GLsizeiptr size = Size_Elem*Dim*sizeof(T);
+							const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+							void* ptr;
+							if(USE_DSA)
+							{
+								ptr = glMapNamedBufferRange(buffer_id, 0, size, access);
+							}
+							else
+							{
+								bindForUpdate();
+								ptr = glMapBufferRange(TargetType::BUFFER_TARGET, 0, size, access);
+							}
+							CHECK_GL_ERROR;
+							if(ptr != nullptr)
+							{
+								std::memcpy(ptr, array, size);
+								if(USE_DSA)
+									glUnmapNamedBuffer(buffer_id);
+								else
+									glUnmapBuffer(TargetType::BUFFER_TARGET);
+								CHECK_GL_ERROR;
+								MemoryStats::upload(size);
+								this->Size_Elem = Size_Elem;
+							}
+							else
+							{
+								std::cerr << "cannot map buffer! --did nothing" << std::endl;
+							}
+							if(!USE_DSA)
+								unbind();
+						}
+
+					//number of elements drawn (must not exceed the capacity)
+					inline void setSizeElem(std::size_t Size_Elem)
+					{
+						this->Size_Elem = std::min(Size_Elem, Capacity_Elem);
+					}
+
+					//std140 block (UniformBuffer)
+
+					template<typename... Members>
+						void copyData(const Std140Layout<Members...> &block)
+						{
+							static_assert(std::is_same<TargetType, UniformBuffer>::value, "std140 block must be copied into UniformBuffer");
+							bufferData(block.size(), block.data());
+							DEBUG_OUT("allocate "<< block.size() <<" B success! buffer id is " << buffer_id);
+							setSizeElem_Dim_Type<GLubyte>(block.size(), 1);
+						}
+
+					template<typename... Members>
+						void subData(const Std140Layout<Members...> &block)
+						{
+							//update whole block with one glBufferSubData
+							static_assert(std::is_same<TargetType, UniformBuffer>::value, "std140 block must be copied into UniformBuffer");
+							if((!isSetArray)||(Size_Elem*Dim*getSizeof(ArrayEnum) != block.size()))
+							{
+								copyData(block);
+								return;
+							}
+							bufferSubData(0, block.size(), block.data());
+						}
+
+					inline void bindBase(GLuint binding) const
+					{
+						static_assert(std::is_same<TargetType, UniformBuffer>::value, "bindBase is for UniformBuffer");
+						BindState::bindBufferBase(TargetType::BUFFER_TARGET, binding, buffer_id);
+						CHECK_GL_ERROR;
+					}
+
+					//GPU-side copy (glCopyBufferSubData). elements [read_offset, read_offset+Size_Elem) of src
+					//go to [write_offset, ...) of this buffer without passing through host memory.
+					//both buffers must have the same element format (type and dimension); any type works.
+					//src may be this buffer if the two ranges do not overlap.
+					template<typename SrcTarget, typename SrcUsage, typename SrcAlloc>
+						void copySubData(std::size_t write_offset, const VertexBuffer<SrcTarget, SrcUsage, SrcAlloc> &src, std::size_t read_offset, std::size_t Size_Elem)
+						{
+							if(!(this->isSetArray && src.getisSetArray()))
+							{
+								std::cerr << "Array is not set. --did nothing" << std::endl;
+								return;
+							}
+							if((this->ArrayEnum != src.getArrayEnum())||(this->Dim != src.getDim()))
+							{
+								std::cerr << "two buffers' element formats are not same --did nothing" << std::endl;
+								return;
+							}
+							if((read_offset+Size_Elem > src.getSizeElem())||(write_offset+Size_Elem > Capacity_Elem))
+							{
+								std::cerr << "copySubData is out of range --did nothing" << std::endl;
+								return;
+							}
+							const std::size_t elem_size = getElemSize();
+							copyBufferSubData(src.getID(), buffer_id, read_offset*elem_size, write_offset*elem_size, Size_Elem*elem_size);
+							this->Size_Elem = std::max(this->Size_Elem, write_offset+Size_Elem);
+						}
+
+					//GPU-side duplicate of src into a new store of this buffer
+					template<typename SrcTarget, typename SrcUsage, typename SrcAlloc>
+						void copyData(const VertexBuffer<SrcTarget, SrcUsage, SrcAlloc> &src)
+						{
+							if(!src.getisSetArray())
+							{
+								std::cerr << "Array is not set. --did nothing" << std::endl;
+								return;
+							}
+							allocateLike(src, src.getSizeElem());
+							copySubData(0, src, 0, src.getSizeElem());
+						}
+
+					//grow the store to Capacity_Elem elements. the drawn elements are copied on the GPU
+					void reserve(std::size_t Capacity_Elem)
+					{
+						if(!isSetArray)
 						{
-							static_assert( is_exist<T, GLbyte, GLubyte, GLshort, GLushort, GLint, GLuint, GLfloat, GLdouble>::value, "Invalid type" );
-							static_assert( (Size_Elem != 0), "Zero Elem" );
-							static_assert((!std::is_same<TargetType,ElementArrayBuffer>::value)||((std::is_same<TargetType,ElementArrayBuffer>::value)&&(is_exist<T,GLubyte,GLushort,GLuint>::value)),
-									"IBO array type must be GLushort or GLuint or GLubyte");
-
-							copyData(&(array[0]), Size_Elem, 1);
+							std::cerr << "Array is not set. --did nothing" << std::endl;
+							return;
 						}
+						if(Capacity_Elem <= this->Capacity_Elem)
+							return;
+						VertexBuffer<TargetType, UsageType, Allocator> grown;
+						grown.allocateLike(*this, Capacity_Elem);
+						grown.copySubData(0, *this, 0, Size_Elem);
+						*this = std::move(grown);
+					}
 
-#if 0
-					VertexBuffer operator+(const VertexBuffer<TargetType, UsageType, Allocator> &obj)
-						//merge buffer data
-						//maybe not be used
+					//append obj after the drawn elements (reallocates if the capacity is not enough)
+					void append(const VertexBuffer<TargetType, UsageType, Allocator> &obj)
 					{
 						if(!(this->isSetArray && obj.isSetArray))
 						{
 							std::cerr << "Array is not set. --did nothing" << std::endl;
-							return *this;
-						}
-						if(this->ArrayEnum != obj.ArrayEnum)
-						{
-							std::cerr << "two types is not same --did nothing" << std::endl;
-							return *this;
+							return;
 						}
-						if(this->Dim != obj.Dim)
+						if(Size_Elem+obj.Size_Elem > Capacity_Elem)
+							reserve(Size_Elem+obj.Size_Elem);
+						copySubData(Size_Elem, obj, 0, obj.Size_Elem);
+					}
+
+					//concatenate buffers into a new one with one glCopyBufferSubData per buffer.
+					//note: element arrays are copied as is. indices are not rebased.
+					static VertexBuffer merge(const std::vector<std::reference_wrapper<const VertexBuffer<TargetType, UsageType, Allocator>>> &buffers)
+					{
+						VertexBuffer<TargetType, UsageType, Allocator> merged;
+						if(buffers.empty())
+							return merged;
+						std::size_t total = 0;
+						for(const VertexBuffer<TargetType, UsageType, Allocator> &buffer : buffers)
 						{
-							std::cerr << "two arrays' dimension is no same --did nothing" << std::endl;
-							return *this;
+							if(!buffer.isSetArray)
+							{
+								std::cerr << "Array is not set. --did nothing" << std::endl;
+								return merged;
+							}
+							total += buffer.Size_Elem;
 						}
+						merged.allocateLike(buffers.front().get(), total);
+						for(const VertexBuffer<TargetType, UsageType, Allocator> &buffer : buffers)
+							merged.copySubData(merged.Size_Elem, buffer, 0, buffer.Size_Elem);
+						return merged;
+					}
 
-						//TODO: this code looks ugly.
+					VertexBuffer operator+(const VertexBuffer<TargetType, UsageType, Allocator> &obj) const
+						//merge buffer data
+					{
+						return merge({*this, obj});
+					}
+			};
 
-						if(this->ArrayEnum == GL_BYTE)
-						{
-							std::vector<GLbyte> t_array(this->Dim*this->Size_Elem);
-							std::vector<GLbyte> o_array(obj.Dim*obj.Size_Elem);
-							std::vector<GLbyte> array(this->Dim*this->Size_Elem+obj.Dim*obj.Size_Elem);
+		//mirrored buffer
 
-							this->bind();
-							GLbyte *temp_t_array = static_cast<GLbyte*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_t_array, temp_t_array+this->Dim*this->Size_Elem, t_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							this->unbind();
+		//note: MirroredBuffer keeps a CPU copy of a VertexBuffer. edits only mark element ranges dirty.
+		//      flush() uploads them with one glBufferSubData per merged range (ranges closer than
+		//      MERGE_GAP bytes are merged). the store grows geometrically, so appends rarely reallocate.
+		template<typename TargetType, typename UsageType, typename T, typename Allocator = DefaultAllocator<Alloc_VertexBuffer>>
+			class MirroredBuffer
+			{
+				private:
+					constexpr static std::size_t MIN_CAPACITY = 16;
+					constexpr static std::size_t MERGE_GAP = 256;
 
-							obj.bind();
-							GLbyte *temp_o_array = static_cast<GLbyte*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_o_array, temp_o_array+obj.Dim*obj.Size_Elem, o_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							obj.unbind();
+					VertexBuffer<TargetType, UsageType, Allocator> buffer;
+					std::vector<T> mirror;
+					std::size_t Dim;
+					std::size_t Capacity_Elem = 0;
+					std::vector<std::pair<std::size_t, std::size_t>> dirty; //[begin, end) in elements
+					bool realloc_needed = false;
 
-							array.insert(array.begin(), t_array.begin(), t_array.end());
-							array.insert(array.begin()+t_array.size(), o_array.begin(), o_array.end());
+					inline void markDirty(std::size_t begin, std::size_t end)
+					{
+						if(begin < end)
+							dirty.emplace_back(begin, end);
+					}
 
-							VertexBuffer<TargetType, UsageType, Allocator> buffer;
-							buffer.copyData(array.data(), this->Size_Elem+obj.Size_Elem, this->Dim);
+					void reserveElem(std::size_t Size_Elem)
+					{
+						if(Size_Elem <= Capacity_Elem)
+							return;
+						Capacity_Elem = std::max(Capacity_Elem*2, Size_Elem);
+						if(Capacity_Elem < MIN_CAPACITY)
+							Capacity_Elem = MIN_CAPACITY;
+						realloc_needed = true;
+					}
 
-							return buffer;
-						}
-						if(this->ArrayEnum == GL_UNSIGNED_BYTE)
-						{
-							std::vector<GLubyte> t_array(this->Dim*this->Size_Elem);
-							std::vector<GLubyte> o_array(obj.Dim*obj.Size_Elem);
-							std::vector<GLubyte> array(this->Dim*this->Size_Elem+obj.Dim*obj.Size_Elem);
+				public:
+					MirroredBuffer(std::size_t Dim = 1)
+						:Dim(Dim){}
 
-							this->bind();
-							GLubyte *temp_t_array = static_cast<GLubyte*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_t_array, temp_t_array+this->Dim*this->Size_Elem, t_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							this->unbind();
+					inline std::size_t size() const
+					{
+						return mirror.size()/Dim;
+					}
 
-							obj.bind();
-							GLubyte *temp_o_array = static_cast<GLubyte*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_o_array, temp_o_array+obj.Dim*obj.Size_Elem, o_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							obj.unbind();
+					inline std::size_t getDim() const
+					{
+						return Dim;
+					}
 
-							array.insert(array.begin(), t_array.begin(), t_array.end());
-							array.insert(array.begin()+t_array.size(), o_array.begin(), o_array.end());
+					inline const T* data() const
+					{
+						return mirror.data();
+					}
 
-							VertexBuffer<TargetType, UsageType, Allocator> buffer;
-							buffer.copyData(array.data(), this->Size_Elem+obj.Size_Elem, this->Dim);
-							return buffer;
-						}
-						if(this->ArrayEnum == GL_SHORT)
-						{
-							std::vector<GLshort> t_array(this->Dim*this->Size_Elem);
-							std::vector<GLshort> o_array(obj.Dim*obj.Size_Elem);
-							std::vector<GLshort> array(this->Dim*this->Size_Elem+obj.Dim*obj.Size_Elem);
+					//pointer to elements [offset, offset+Size_Elem) marked dirty
+					T* modify(std::size_t offset, std::size_t Size_Elem)
+					{
+						assert(offset+Size_Elem <= size());
+						markDirty(offset, offset+Size_Elem);
+						return mirror.data()+offset*Dim;
+					}
 
-							this->bind();
-							GLshort *temp_t_array = static_cast<GLshort*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_t_array, temp_t_array+this->Dim*this->Size_Elem, t_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							this->unbind();
+					void set(std::size_t offset, const T* array, std::size_t Size_Elem)
+					{
+						std::copy(array, array+Size_Elem*Dim, modify(offset, Size_Elem));
+					}
 
-							obj.bind();
-							GLshort *temp_o_array = static_cast<GLshort*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_o_array, temp_o_array+obj.Dim*obj.Size_Elem, o_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							obj.unbind();
+					void append(const T* array, std::size_t Size_Elem)
+					{
+						std::size_t old_size = size();
+						reserveElem(old_size+Size_Elem);
+						mirror.insert(mirror.end(), array, array+Size_Elem*Dim);
+						markDirty(old_size, old_size+Size_Elem);
+					}
+
+					void resize(std::size_t Size_Elem)
+					{
+						std::size_t old_size = size();
+						reserveElem(Size_Elem);
+						mirror.resize(Size_Elem*Dim);
+						markDirty(old_size, Size_Elem);
+					}
 
-							array.insert(array.begin(), t_array.begin(), t_array.end());
-							array.insert(array.begin()+t_array.size(), o_array.begin(), o_array.end());
+					inline void clear()
+					{
+						mirror.clear();
+						dirty.clear();
+					}
 
-							VertexBuffer<TargetType, UsageType, Allocator> buffer;
-							buffer.copyData(array.data(), this->Size_Elem+obj.Size_Elem, this->Dim);
-							return buffer;
+					//upload dirty ranges (or the whole array after the store grew)
+					void flush()
+					{
+						if(realloc_needed)
+						{
+							buffer.template allocate<T>(Capacity_Elem, Dim);
+							if(!mirror.empty())
+								buffer.subData(0, mirror.data(), size());
+							realloc_needed = false;
+							dirty.clear();
+							return;
 						}
-						if(this->ArrayEnum == GL_UNSIGNED_SHORT)
+						buffer.setSizeElem(size());
+						if(dirty.empty())
+							return;
+						std::sort(dirty.begin(), dirty.end());
+						const std::size_t gap = std::max<std::size_t>(MERGE_GAP/(Dim*sizeof(T)), 1);
+						std::size_t begin = dirty[0].first;
+						std::size_t end = dirty[0].second;
+						for(std::size_t i=1; i<=dirty.size(); i++)
 						{
-							std::vector<GLushort> t_array(this->Dim*this->Size_Elem);
-							std::vector<GLushort> o_array(obj.Dim*obj.Size_Elem);
-							std::vector<GLushort> array(this->Dim*this->Size_Elem+obj.Dim*obj.Size_Elem);
+							if((i < dirty.size())&&(dirty[i].first <= end+gap))
+							{
+								end = std::max(end, dirty[i].second);
+								continue;
+							}
+							end = std::min(end, size());
+							if(begin < end)
+								buffer.subData(begin, mirror.data()+begin*Dim, end-begin);
+							if(i < dirty.size())
+							{
+								begin = dirty[i].first;
+								end = dirty[i].second;
+							}
+						}
+						dirty.clear();
+					}
 
-							this->bind();
-							GLushort *temp_t_array = static_cast<GLushort*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_t_array, temp_t_array+this->Dim*this->Size_Elem, t_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							this->unbind();
+					//flush() before drawing with it
+					inline const VertexBuffer<TargetType, UsageType, Allocator>& getBuffer() const
+					{
+						return buffer;
+					}
+			};
 
-							obj.bind();
-							GLushort *temp_o_array = static_cast<GLushort*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_o_array, temp_o_array+obj.Dim*obj.Size_Elem, o_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							obj.unbind();
+		//interleaved buffer
+
+		//note: InterleavedBuffer keeps every attribute of Format in one ArrayBuffer, one vertex after another.
+		//      the wrapped VertexBuffer holds Size_Elem vertices of Format::stride() bytes (GL_UNSIGNED_BYTE x stride),
+		//      so draw() counts vertices as usual. GLObject::connectAttrib sets up all attributes at once.
+		template<typename Format, typename UsageType = StaticDraw, typename Allocator = DefaultAllocator<Alloc_VertexBuffer>>
+			class InterleavedBuffer
+			{
+				private:
+					VertexBuffer<ArrayBuffer, UsageType, Allocator> buffer;
 
-							array.insert(array.begin(), t_array.begin(), t_array.end());
-							array.insert(array.begin()+t_array.size(), o_array.begin(), o_array.end());
+				public:
+					using format_type = Format;
 
-							VertexBuffer<TargetType, UsageType, Allocator> buffer;
-							buffer.copyData(array.data(), this->Size_Elem+obj.Size_Elem, this->Dim);
-							return buffer;
-						}
-						if(this->ArrayEnum == GL_INT)
+					inline bool getisSetArray() const
+					{
+						return buffer.getisSetArray();
+					}
+					inline std::size_t getSizeElem() const
+					{
+						return buffer.getSizeElem();
+					}
+					inline GLuint getID() const
+					{
+						return buffer.getID();
+					}
+					inline void setLabel(const std::string &label) const
+					{
+						buffer.setLabel(label);
+					}
+
+					//vertices already laid out as Format (ex. an array of structs)
+					template<typename Vertex>
+						void copyData(const Vertex* vertices, std::size_t Size_Elem)
 						{
-							std::vector<GLint> t_array(this->Dim*this->Size_Elem);
-							std::vector<GLint> o_array(obj.Dim*obj.Size_Elem);
-							std::vector<GLint> array(this->Dim*this->Size_Elem+obj.Dim*obj.Size_Elem);
+							static_assert(sizeof(Vertex) == Format::stride(), "size of vertex is not same as stride of Format");
+							static_assert(std::is_standard_layout<Vertex>::value, "vertex must be standard layout");
+							buffer.copyData(reinterpret_cast<const GLubyte*>(vertices), Size_Elem, Format::stride());
+						}
 
-							this->bind();
-							GLint *temp_t_array = static_cast<GLint*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_t_array, temp_t_array+this->Dim*this->Size_Elem, t_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							this->unbind();
+					//one tightly packed array per attribute, interleaved on the CPU before the upload
+					template<typename... Ts>
+						void copyData(std::size_t Size_Elem, const Ts*... arrays)
+						{
+							static_assert(sizeof...(Ts) == Format::NUM_ATTRIB, "one array per attribute is needed");
+							std::vector<GLubyte> staging(Size_Elem*Format::stride());
+							Format::interleave(staging.data(), Format::stride(), Size_Elem, arrays...);
+							buffer.copyData(staging.data(), Size_Elem, Format::stride());
+						}
 
-							obj.bind();
-							GLint *temp_o_array = static_cast<GLint*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_o_array, temp_o_array+obj.Dim*obj.Size_Elem, o_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							obj.unbind();
+					//store for Capacity_Elem vertices without data
+					inline void allocate(std::size_t Capacity_Elem, std::size_t Size_Elem = 0)
+					{
+						buffer.template allocate<GLubyte>(Capacity_Elem, Format::stride(), Size_Elem);
+					}
 
-							array.insert(array.begin(), t_array.begin(), t_array.end());
-							array.insert(array.begin()+t_array.size(), o_array.begin(), o_array.end());
+					inline std::size_t getCapacityElem() const
+					{
+						return buffer.getCapacityElem();
+					}
 
-							VertexBuffer<TargetType, UsageType, Allocator> buffer;
-							buffer.copyData(array.data(), this->Size_Elem+obj.Size_Elem, this->Dim);
-							return buffer;
+					//overwrite vertices [offset, offset+Size_Elem), arrays as in copyData
+					template<typename Vertex>
+						void subData(std::size_t offset, const Vertex* vertices, std::size_t Size_Elem)
+						{
+							static_assert(sizeof(Vertex) == Format::stride(), "size of vertex is not same as stride of Format");
+							static_assert(std::is_standard_layout<Vertex>::value, "vertex must be standard layout");
+							buffer.subData(offset, reinterpret_cast<const GLubyte*>(vertices), Size_Elem);
 						}
-						if(this->ArrayEnum == GL_UNSIGNED_INT)
+
+					template<typename... Ts>
+						void subData(std::size_t offset, std::size_t Size_Elem, const Ts*... arrays)
 						{
-							std::vector<GLuint> t_array(this->Dim*this->Size_Elem);
-							std::vector<GLuint> o_array(obj.Dim*obj.Size_Elem);
-							std::vector<GLuint> array(this->Dim*this->Size_Elem+obj.Dim*obj.Size_Elem);
+							static_assert(sizeof...(Ts) == Format::NUM_ATTRIB, "one array per attribute is needed");
+							std::vector<GLubyte> staging(Size_Elem*Format::stride());
+							Format::interleave(staging.data(), Format::stride(), Size_Elem, arrays...);
+							buffer.subData(offset, staging.data(), Size_Elem);
+						}
 
-							this->bind();
-							GLuint *temp_t_array = static_cast<GLuint*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_t_array, temp_t_array+this->Dim*this->Size_Elem, t_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							this->unbind();
+					inline const VertexBuffer<ArrayBuffer, UsageType, Allocator>& getBuffer() const
+					{
+						return buffer;
+					}
+			};
 
-							obj.bind();
-							GLuint *temp_o_array = static_cast<GLuint*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_o_array, temp_o_array+obj.Dim*obj.Size_Elem, o_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							obj.unbind();
+		//persistent mapped ring buffer
 
-							array.insert(array.begin(), t_array.begin(), t_array.end());
-							array.insert(array.begin()+t_array.size(), o_array.begin(), o_array.end());
+		//note: RingBuffer is one immutable store (glBufferStorage, ARB_buffer_storage or GL4.4) that stays
+		//      mapped with GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT. it is split into NumRegion frame regions.
+		//      beginFrame() waits for the fence of the region it reuses, push()/allocate() bump-allocate in it,
+		//      endFrame() fences it. the CPU writes GPU-visible memory with no map/unmap per draw.
+		template<typename TargetType = UniformBuffer, std::size_t NumRegion = 3, typename Allocator = DefaultAllocator<Alloc_VertexBuffer>>
+			class RingBuffer
+			{
+				static_assert(NumRegion >= 2, "RingBuffer needs 2 or more regions");
 
-							VertexBuffer<TargetType, UsageType, Allocator> buffer;
-							buffer.copyData(array.data(), this->Size_Elem+obj.Size_Elem, this->Dim);
-							return buffer;
-						}
-						if(this->ArrayEnum == GL_FLOAT)
-						{
-							std::vector<GLfloat> t_array(this->Dim*this->Size_Elem);
-							std::vector<GLfloat> o_array(obj.Dim*obj.Size_Elem);
-							std::vector<GLfloat> array(this->Dim*this->Size_Elem+obj.Dim*obj.Size_Elem);
+				public:
+					struct Allocation
+					{
+						void* ptr;
+						GLintptr offset; //from the start of the whole store
+						GLsizeiptr size;
+					};
 
-							this->bind();
-							GLfloat *temp_t_array = static_cast<GLfloat*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_t_array, temp_t_array+this->Dim*this->Size_Elem, t_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							this->unbind();
+				private:
+					GLuint buffer_id;
+					Allocator a;
+					GLubyte* mapped;
+					std::size_t region_size;
+					std::size_t region;
+					std::size_t head;
+					std::size_t offset_align;
+					std::array<GLsync, NumRegion> fences;
 
-							obj.bind();
-							GLfloat *temp_o_array = static_cast<GLfloat*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_o_array, temp_o_array+obj.Dim*obj.Size_Elem, o_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							obj.unbind();
+					RingBuffer(const RingBuffer &);
+					RingBuffer& operator=(const RingBuffer &);
 
-							array.insert(array.begin(), t_array.begin(), t_array.end());
-							array.insert(array.begin()+t_array.size(), o_array.begin(), o_array.end());
+				public:
+					static inline bool isSupported()
+					{
+						return GLEW_ARB_buffer_storage || GLEW_VERSION_4_4;
+					}
 
-							VertexBuffer<TargetType, UsageType, Allocator> buffer;
-							buffer.copyData(array.data(), this->Size_Elem+obj.Size_Elem, this->Dim);
-							return buffer;
+					RingBuffer(std::size_t region_size)
+						:mapped(nullptr), region_size(region_size), region(0), head(0), offset_align(1)
+					{
+						fences.fill(nullptr);
+						if(std::is_same<TargetType, UniformBuffer>::value)
+						{
+							GLint align;
+							glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align);
+							offset_align = static_cast<std::size_t>(std::max(align, 1));
+						}
+						//every region must start on the offset alignment
+						this->region_size = std140_roundup(region_size, offset_align);
+						const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+						const GLsizeiptr size = this->region_size*NumRegion;
+						buffer_id = a.construct();
+						if(USE_DSA)
+						{
+							glNamedBufferStorage(buffer_id, size, NULL, flags);
+							mapped = static_cast<GLubyte*>(glMapNamedBufferRange(buffer_id, 0, size, flags));
 						}
-						if(this->ArrayEnum == GL_DOUBLE)
+						else
 						{
-							std::vector<GLdouble> t_array(this->Dim*this->Size_Elem);
-							std::vector<GLdouble> o_array(obj.Dim*obj.Size_Elem);
-							std::vector<GLdouble> array(this->Dim*this->Size_Elem+obj.Dim*obj.Size_Elem);
+							BindState::bindBuffer(TargetType::BUFFER_TARGET, buffer_id);
+							glBufferStorage(TargetType::BUFFER_TARGET, size, NULL, flags);
+							mapped = static_cast<GLubyte*>(glMapBufferRange(TargetType::BUFFER_TARGET, 0, size, flags));
+							if(!BindState::isLazyUnbind())
+								BindState::bindBuffer(TargetType::BUFFER_TARGET, 0);
+						}
+						CHECK_GL_ERROR;
+						if(mapped == nullptr)
+							std::cerr << "cannot map ring buffer! (needs ARB_buffer_storage)" << std::endl;
+						MemoryStats::allocate<Alloc_VertexBuffer>(buffer_id, size);
+						DEBUG_OUT("ring buffer created! id is " << buffer_id << ", " << NumRegion << " x " << this->region_size << " B");
+					}
 
-							this->bind();
-							GLdouble *temp_t_array = static_cast<GLdouble*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_t_array, temp_t_array+this->Dim*this->Size_Elem, t_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							this->unbind();
+					~RingBuffer()
+					{
+						for(auto&& fence : fences)
+							if(fence != nullptr)
+								glDeleteSync(fence);
+						if(mapped != nullptr)
+						{
+							if(USE_DSA)
+								glUnmapNamedBuffer(buffer_id);
+							else
+							{
+								BindState::bindBuffer(TargetType::BUFFER_TARGET, buffer_id);
+								glUnmapBuffer(TargetType::BUFFER_TARGET);
+							}
+						}
+						a.destruct(buffer_id);
+						CHECK_GL_ERROR;
+						DEBUG_OUT("ring buffer id " << buffer_id << " destructed!");
+					}
 
-							obj.bind();
-							GLdouble *temp_o_array = static_cast<GLdouble*>(glMapBuffer(TargetType::BUFFER_TARGET, GL_READ_ONLY));
-							CHECK_GL_ERROR;
-							std::copy(temp_o_array, temp_o_array+obj.Dim*obj.Size_Elem, o_array.begin());
-							glUnmapBuffer(TargetType::BUFFER_TARGET);
-							CHECK_GL_ERROR;
-							obj.unbind();
+					inline GLuint getID() const
+					{
+						return buffer_id;
+					}
+
+					//move to the next region. blocks only if the GPU is still NumRegion-1 frames behind
+					void beginFrame()
+					{
+						region = (region + 1) % NumRegion;
+						head = 0;
+						GLsync &fence = fences[region];
+						if(fence == nullptr)
+							return;
+						GLbitfield wait_flags = 0;
+						while(true)
+						{
+							GLenum result = glClientWaitSync(fence, wait_flags, 1000000);
+							if((result == GL_ALREADY_SIGNALED)||(result == GL_CONDITION_SATISFIED)||(result == GL_WAIT_FAILED))
+								break;
+							wait_flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+						}
+						glDeleteSync(fence);
+						fence = nullptr;
+					}
 
-							array.insert(array.begin(), t_array.begin(), t_array.end());
-							array.insert(array.begin()+t_array.size(), o_array.begin(), o_array.end());
+					//call after the last draw call that reads this frame's region
+					void endFrame()
+					{
+						if(fences[region] != nullptr)
+							glDeleteSync(fences[region]);
+						fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+					}
 
-							VertexBuffer<TargetType, UsageType, Allocator> buffer;
-							buffer.copyData(array.data(), this->Size_Elem+obj.Size_Elem, this->Dim);
-							return buffer;
+					//bump allocation in the current region. ptr is nullptr if the region is full
+					Allocation allocate(std::size_t size, std::size_t align = 1)
+					{
+						align = std::max(align, offset_align);
+						//align the offset from the start of the store, not of the region
+						const std::size_t region_begin = region*region_size;
+						std::size_t begin = std140_roundup(region_begin + head, align) - region_begin;
+						if((mapped == nullptr)||(begin + size > region_size))
+						{
+							std::cerr << "ring buffer region is full! --did nothing" << std::endl;
+							return {nullptr, 0, 0};
 						}
+						head = begin + size;
+						GLintptr offset = region_begin + begin;
+						MemoryStats::upload(size);
+						return {mapped + offset, offset, static_cast<GLsizeiptr>(size)};
+					}
 
-						std::cerr << "invalid enum --did nothing" << std::endl;
-						return *this;
+					template<typename T>
+						Allocation push(const T* array, std::size_t Size_Elem)
+						{
+							Allocation alloc = allocate(Size_Elem*sizeof(T), alignof(T));
+							if(alloc.ptr != nullptr)
+								std::memcpy(alloc.ptr, array, alloc.size);
+							return alloc;
+						}
+
+					template<typename... Members>
+						Allocation push(const Std140Layout<Members...> &block)
+						{
+							return push(block.data(), block.size());
+						}
+
+					//bind an allocation to a uniform block binding point (glBindBufferRange)
+					inline void bindRange(GLuint binding, const Allocation &alloc) const
+					{
+						static_assert(std::is_same<TargetType, UniformBuffer>::value, "bindRange is for UniformBuffer");
+						BindState::bindBufferRange(TargetType::BUFFER_TARGET, binding, buffer_id, alloc.offset, alloc.size);
+						CHECK_GL_ERROR;
+					}
 
+					//bytes used in the current region
+					inline std::size_t getUsed() const
+					{
+						return head;
 					}
-#endif
 			};
 
 		//vertexarray
-		template<typename Allocator=GLAllocator<Alloc_VertexArray>> 
+		template<typename Allocator=DefaultAllocator<Alloc_VertexArray>> 
 			class VertexArray
 			{
 				private:
@@ -927,19 +2103,27 @@ namespace jikoLib{
 
 					inline void bind() const
 					{
-						glBindVertexArray(varray_id);
+						BindState::bindVertexArray(varray_id);
 						CHECK_GL_ERROR;
 					}
 
 					inline void unbind() const
 					{
-						glBindVertexArray(0);
+						if(BindState::isLazyUnbind())
+							return;
+						BindState::bindVertexArray(0);
 						CHECK_GL_ERROR;
 					}
 
 					template<typename IBOAlloc>
 						inline void bindIBO(const VertexBuffer<ElementArrayBuffer, IBOAlloc> &ibo) const
 						{
+							if(USE_DSA)
+							{
+								glVertexArrayElementBuffer(varray_id, ibo.getID());
+								CHECK_GL_ERROR;
+								return;
+							}
 							bind();
 							ibo.bind();
 							unbind();
@@ -947,8 +2131,15 @@ namespace jikoLib{
 					template<typename IBOAlloc>
 						inline void unbindIBO(const VertexBuffer<ElementArrayBuffer, IBOAlloc> &ibo) const
 						{
+							if(USE_DSA)
+							{
+								glVertexArrayElementBuffer(varray_id, 0);
+								CHECK_GL_ERROR;
+								return;
+							}
 							bind();
-							ibo.unbind();
+							//explicit. ibo.unbind() does nothing with lazy unbind
+							BindState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 							unbind();
 						}
 
@@ -957,15 +2148,21 @@ namespace jikoLib{
 					{
 						varray_id = a.construct();
 						CHECK_GL_ERROR;
-						bind();
+						//glGen* name becomes an object on first bind. glCreate* does not need it
+						if(!USE_DSA)
+						{
+							bind();
+							unbind();
+						}
 						DEBUG_OUT("varray created! id is " << varray_id);
-						unbind();
 					}
 
 					~VertexArray()
 					{
-						a.destruct(varray_id);
-						CHECK_GL_ERROR;
+						if(a.destruct(varray_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						DEBUG_OUT("varray id " << varray_id << " destructed!");
 					}
 
@@ -974,7 +2171,6 @@ namespace jikoLib{
 						this->varray_id = obj.varray_id;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("varray copied! id is " << varray_id);
 					}
 
@@ -983,28 +2179,31 @@ namespace jikoLib{
 						this->varray_id = obj.varray_id;
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("varray moved! id is " << varray_id);
 					}
 
 					VertexArray& operator=(const VertexArray<Allocator> &obj)
 					{
-						a.destruct(varray_id);
+						if(a.destruct(varray_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->varray_id = obj.varray_id;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("varray copied! id is " << varray_id);
 						return *this;
 					}
 
 					VertexArray& operator=(VertexArray<Allocator>&& obj)
 					{
-						a.destruct(varray_id);
+						if(a.destruct(varray_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->varray_id = obj.varray_id;
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("varray moved! id is " << varray_id);
 						return *this;
 					}
@@ -1017,7 +2216,7 @@ namespace jikoLib{
 
 		//texture
 
-		template<typename TargetType, typename Allocator = GLAllocator<Alloc_Texture>> 
+		template<typename TargetType, typename Allocator = DefaultAllocator<Alloc_Texture>> 
 			class Texture
 			{
 				private:
@@ -1027,11 +2226,11 @@ namespace jikoLib{
 
 					void setInitParam()
 					{
-						glTexParameteri(TargetType::TEXTURE_TARGET, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-						glTexParameteri(TargetType::TEXTURE_TARGET, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-						glTexParameteri(TargetType::TEXTURE_TARGET, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-						glTexParameteri(TargetType::TEXTURE_TARGET, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-						glTexParameteri(TargetType::TEXTURE_TARGET, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+						texParameteri(TargetType::TEXTURE_TARGET, texture_id, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+						texParameteri(TargetType::TEXTURE_TARGET, texture_id, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+						texParameteri(TargetType::TEXTURE_TARGET, texture_id, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+						texParameteri(TargetType::TEXTURE_TARGET, texture_id, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+						texParameteri(TargetType::TEXTURE_TARGET, texture_id, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 					}
 
 				public:
@@ -1042,31 +2241,40 @@ namespace jikoLib{
 							std::cerr << "TextureUnit must be between 0 to 32. -- set TextureUnit 0" << std::endl;
 							TexUnitNum = 0;
 						}
-						glActiveTexture(GL_TEXTURE0 + TexUnitNum);
-						glBindTexture(TargetType::TEXTURE_TARGET, texture_id);
+						BindState::activeTexture(TexUnitNum);
+						BindState::bindTexture(TargetType::TEXTURE_TARGET, texture_id);
 						CHECK_GL_ERROR;
 					}
 
 					inline void unbind() const
 					{
-						glBindTexture(TargetType::TEXTURE_TARGET, 0);
+						if(BindState::isLazyUnbind())
+							return;
+						BindState::bindTexture(TargetType::TEXTURE_TARGET, 0);
 						CHECK_GL_ERROR;
 					}
 
 					Texture()
 					{
-						texture_id = a.construct();
+						texture_id = a.construct(TargetType::TEXTURE_TARGET);
 						CHECK_GL_ERROR;
-						bind();
 						DEBUG_OUT("texture created! id is " << texture_id);
+						if(USE_DSA)
+						{
+							setInitParam();
+							return;
+						}
+						bind();
 						setInitParam();
 						unbind();
 					}
 
 					~Texture()
 					{
-						a.destruct(texture_id);
-						CHECK_GL_ERROR;
+						if(a.destruct(texture_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						DEBUG_OUT("texture id " << texture_id << " destructed!");
 					}
 
@@ -1075,7 +2283,6 @@ namespace jikoLib{
 						this->texture_id = obj.texture_id;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("texture copied! id is " << texture_id);
 					}
 
@@ -1084,28 +2291,31 @@ namespace jikoLib{
 						this->texture_id = obj.texture_id;
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("texture moved! id is " << texture_id);
 					}
 
 					Texture& operator=(const Texture<TargetType, Allocator> &obj)
 					{
-						a.destruct(texture_id);
+						if(a.destruct(texture_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->texture_id = obj.texture_id;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("texture copied! id is " << texture_id);
 						return *this;
 					}
 
 					Texture& operator=(Texture<TargetType, Allocator>&& obj)
 					{
-						a.destruct(texture_id);
+						if(a.destruct(texture_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->texture_id = obj.texture_id;
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("texture moved! id is " << texture_id);
 						return *this;
 					}
@@ -1115,21 +2325,36 @@ namespace jikoLib{
 						return texture_id;
 					}
 
+					//name shown in MemoryStats::getLabelBytes()
+					inline void setLabel(const std::string &label) const
+					{
+						MemoryStats::setLabel<Alloc_Texture>(texture_id, label);
+					}
+
 
 					template<typename TextureType = GLubyte, GLint level = 0, typename int_format = RGBA, typename format = RGBA, typename... Args>
 						inline void texImage2D(Args&&... args)
 						{
 							static_assert(is_exist<TargetType, Texture2D, TextureCubeMap>::value, "invalid type");
 							bind();
-							TextureTraits<TargetType, level, int_format, format, TextureType>::texImage2D(std::forward<Args>(args)...);
+							std::size_t bytes = TextureTraits<TargetType, level, int_format, format, TextureType>::texImage2D(std::forward<Args>(args)...);
 							unbind();
+							if(level == 0)
+								MemoryStats::allocate<Alloc_Texture>(texture_id, bytes);
+							else
+								MemoryStats::allocateLevel<Alloc_Texture>(texture_id, bytes);
 						}
 
 					template<typename... Args>
 						void setParameter()
 						{
+							if(USE_DSA)
+							{
+								SetParamTraits<Args...>::func(TargetType::TEXTURE_TARGET, texture_id);
+								return;
+							}
 							bind();
-							SetParamTraits<Args...>::func(TargetType::TEXTURE_TARGET);
+							SetParamTraits<Args...>::func(TargetType::TEXTURE_TARGET, texture_id);
 							unbind();
 						}
 
@@ -1139,6 +2364,12 @@ namespace jikoLib{
 						static_assert(is_all_same<GLfloat, Args...>::value, "array type must be GLfloat");
 						const GLfloat array[] = {args...};
 						static_assert(length(array)==4, "array size must be 4");
+						if(USE_DSA)
+						{
+							glTextureParameterfv(texture_id, GL_TEXTURE_BORDER_COLOR, array);
+							CHECK_GL_ERROR;
+							return;
+						}
 						bind();
 						glTexParameterfv(TargetType::TEXTURE_TARGET, GL_TEXTURE_BORDER_COLOR, array);
 						CHECK_GL_ERROR;
@@ -1147,6 +2378,14 @@ namespace jikoLib{
 
 					void generateMipmap()
 					{
+						MemoryStats::allocateMipmap<Alloc_Texture>(texture_id);
+						if(USE_DSA)
+						{
+							//GL_GENERATE_MIPMAP is not in core profile
+							glGenerateTextureMipmap(texture_id);
+							CHECK_GL_ERROR;
+							return;
+						}
 						bind();
 						setParameter<GenerateMipmap<GL_TRUE>>();
 						glGenerateMipmap(TargetType::TEXTURE_TARGET);
@@ -1162,7 +2401,7 @@ namespace jikoLib{
 
 		//framebuffer
 
-		template<typename TargetType = ReadDrawFrameBuffer, typename Allocator = GLAllocator<Alloc_FrameBuffer>>
+		template<typename TargetType = ReadDrawFrameBuffer, typename Allocator = DefaultAllocator<Alloc_FrameBuffer>>
 			class FrameBuffer{
 				private:
 					GLuint framebuffer_id;
@@ -1171,13 +2410,14 @@ namespace jikoLib{
 				public:
 					inline void bind() const
 					{
-						glBindFramebuffer(TargetType::FRAMEBUFFER_TARGET, framebuffer_id);
+						BindState::bindFramebuffer(TargetType::FRAMEBUFFER_TARGET, framebuffer_id);
 						CHECK_GL_ERROR;
 					}
 
 					inline void unbind() const
 					{
-						glBindFramebuffer(TargetType::FRAMEBUFFER_TARGET, 0);
+						//never lazy. default framebuffer must be restored
+						BindState::bindFramebuffer(TargetType::FRAMEBUFFER_TARGET, 0);
 						CHECK_GL_ERROR;
 					}
 
@@ -1185,15 +2425,21 @@ namespace jikoLib{
 					{
 						framebuffer_id = a.construct();
 						CHECK_GL_ERROR;
-						bind();
+						//glGen* name becomes an object on first bind. glCreate* does not need it
+						if(!USE_DSA)
+						{
+							bind();
+							unbind();
+						}
 						DEBUG_OUT("framebuffer created! id is " << framebuffer_id);
-						unbind();
 					}
 
 					~FrameBuffer()
 					{
-						a.destruct(framebuffer_id);
-						CHECK_GL_ERROR;
+						if(a.destruct(framebuffer_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						DEBUG_OUT("framebuffer id " << framebuffer_id << " destructed!");
 					}
 
@@ -1202,7 +2448,6 @@ namespace jikoLib{
 						this->framebuffer_id = obj.framebuffer_id;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("framebuffer copied! id is " << framebuffer_id);
 					}
 
@@ -1211,28 +2456,31 @@ namespace jikoLib{
 						this->framebuffer_id = obj.framebuffer_id;
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("framebuffer moved! id is " << framebuffer_id);
 					}
 
 					FrameBuffer& operator=(const FrameBuffer<TargetType, Allocator> &obj)
 					{
-						a.destruct(framebuffer_id);
+						if(a.destruct(framebuffer_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->framebuffer_id = obj.framebuffer_id;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("framebuffer copied! id is " << framebuffer_id);
 						return *this;
 					}
 
 					FrameBuffer& operator=(FrameBuffer<TargetType, Allocator>&& obj)
 					{
-						a.destruct(framebuffer_id);
+						if(a.destruct(framebuffer_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->framebuffer_id = obj.framebuffer_id;
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("framebuffer moved! id is " << framebuffer_id);
 						return *this;
 					}
@@ -1247,6 +2495,12 @@ namespace jikoLib{
 					template<typename Attachment, typename attachTargetType = TargetType, typename RBO_TargetType, typename RBO_Alloc>
 						void attach(const RenderBuffer<RBO_TargetType, RBO_Alloc> &rbo)
 						{
+							if(USE_DSA)
+							{
+								glNamedFramebufferRenderbuffer(framebuffer_id, Attachment::ATTACHMENT, RBO_TargetType::RENDERBUFFER_TARGET, rbo.getID());
+								CHECK_GL_ERROR;
+								return;
+							}
 							bind();
 							rbo.bind();
 							glFramebufferRenderbuffer(attachTargetType::FRAMEBUFFER_TARGET, Attachment::ATTACHMENT, RBO_TargetType::RENDERBUFFER_TARGET, rbo.getID());
@@ -1259,6 +2513,12 @@ namespace jikoLib{
 					template<typename Attachment, typename attachTargetType = TargetType, typename RBO_TargetType, typename RBO_Alloc>
 						void detach(const RenderBuffer<RBO_TargetType, RBO_Alloc> &rbo)
 						{
+							if(USE_DSA)
+							{
+								glNamedFramebufferRenderbuffer(framebuffer_id, Attachment::ATTACHMENT, RBO_TargetType::RENDERBUFFER_TARGET, 0);
+								CHECK_GL_ERROR;
+								return;
+							}
 							bind();
 							rbo.bind();
 							glFramebufferRenderbuffer(attachTargetType::FRAMEBUFFER_TARGET, Attachment::ATTACHMENT, RBO_TargetType::RENDERBUFFER_TARGET, 0);
@@ -1274,6 +2534,12 @@ namespace jikoLib{
 						void attach(const Texture<tex_TargetType, tex_Alloc>& tex)
 						{
 							static_assert(!is_exist<tex_TargetType, Texture3D, TextureCubeMap>::value, "invalid type");
+							if(USE_DSA)
+							{
+								glNamedFramebufferTexture(framebuffer_id, Attachment::ATTACHMENT, tex.getID(), level);
+								CHECK_GL_ERROR;
+								return;
+							}
 							bind();
 							tex.bind();
 							fbAttachTraits<tex_TargetType>::func(attachTargetType::FRAMEBUFFER_TARGET, Attachment::ATTACHMENT, tex_TargetType::TEXTURE_TARGET, tex.getID(), level);
@@ -1288,6 +2554,12 @@ namespace jikoLib{
 					template<typename Attachment, typename attachTargetType = TargetType, GLint level = 0, typename tex_Alloc>
 						void attach(const Texture<Texture3D, tex_Alloc>& tex, GLint layer)
 						{
+							if(USE_DSA)
+							{
+								glNamedFramebufferTextureLayer(framebuffer_id, Attachment::ATTACHMENT, tex.getID(), level, layer);
+								CHECK_GL_ERROR;
+								return;
+							}
 							bind();
 							tex.bind();
 							fbAttachTraits<Texture3D>::func(attachTargetType::FRAMEBUFFER_TARGET, Attachment::ATTACHMENT, Texture3D::TEXTURE_TARGET, tex.getID(), level, layer);
@@ -1302,6 +2574,13 @@ namespace jikoLib{
 					template<typename Attachment, typename CubeMapType, typename attachTargetType = TargetType, GLint level = 0, typename tex_Alloc>
 						void attach(const Texture<TextureCubeMap, tex_Alloc>& tex)
 						{
+							//cubemap face is a layer in DSA
+							if(USE_DSA)
+							{
+								glNamedFramebufferTextureLayer(framebuffer_id, Attachment::ATTACHMENT, tex.getID(), level, CubeMapType::CUBEMAP_VALUE - GL_TEXTURE_CUBE_MAP_POSITIVE_X);
+								CHECK_GL_ERROR;
+								return;
+							}
 							bind();
 							tex.bind();
 							fbAttachTraits<TextureCubeMap>::func(attachTargetType::FRAMEBUFFER_TARGET, Attachment::ATTACHMENT, CubeMapType::CUBEMAP_VALUE, tex.getID(), level);
@@ -1317,6 +2596,12 @@ namespace jikoLib{
 						void detach(const Texture<tex_TargetType, tex_Alloc>& tex)
 						{
 							static_assert(!is_exist<tex_TargetType, Texture3D, TextureCubeMap>::value, "invalid type");
+							if(USE_DSA)
+							{
+								glNamedFramebufferTexture(framebuffer_id, Attachment::ATTACHMENT, 0, level);
+								CHECK_GL_ERROR;
+								return;
+							}
 							bind();
 							tex.bind();
 							fbAttachTraits<tex_TargetType>::func(attachTargetType::FRAMEBUFFER_TARGET, Attachment::ATTACHMENT, tex_TargetType::TEXTURE_TARGET, 0, level);
@@ -1331,6 +2616,12 @@ namespace jikoLib{
 					template<typename Attachment, typename attachTargetType = TargetType, GLint level = 0, typename tex_Alloc>
 						void detach(const Texture<Texture3D, tex_Alloc>& tex, GLint layer)
 						{
+							if(USE_DSA)
+							{
+								glNamedFramebufferTextureLayer(framebuffer_id, Attachment::ATTACHMENT, 0, level, layer);
+								CHECK_GL_ERROR;
+								return;
+							}
 							bind();
 							tex.bind();
 							fbAttachTraits<Texture3D>::func(attachTargetType::FRAMEBUFFER_TARGET, Attachment::ATTACHMENT, Texture3D::TEXTURE_TARGET, 0, level, layer);
@@ -1345,6 +2636,12 @@ namespace jikoLib{
 					template<typename Attachment, typename CubeMapType, typename attachTargetType = TargetType, GLint level = 0, typename tex_Alloc>
 						void detach(const Texture<TextureCubeMap, tex_Alloc>& tex)
 						{
+							if(USE_DSA)
+							{
+								glNamedFramebufferTexture(framebuffer_id, Attachment::ATTACHMENT, 0, level);
+								CHECK_GL_ERROR;
+								return;
+							}
 							bind();
 							tex.bind();
 							fbAttachTraits<TextureCubeMap>::func(attachTargetType::FRAMEBUFFER_TARGET, Attachment::ATTACHMENT, CubeMapType::CUBEMAP_VALUE, 0, level);
@@ -1358,9 +2655,15 @@ namespace jikoLib{
 						void drawBuffer(Args... args)
 						{
 							//static_assert(is_all_same<GLenum, Args...>::value, "Args must be GLenum");
-							bind();
 							const GLenum array[] = {static_cast<GLenum>(args)...};
 							static_assert(length(array) <= 6, "array length must be under 6");
+							if(USE_DSA)
+							{
+								glNamedFramebufferDrawBuffers(framebuffer_id, length(array), array);
+								CHECK_GL_ERROR;
+								return;
+							}
+							bind();
 							glDrawBuffers(length(array), array);
 							CHECK_GL_ERROR;
 							unbind();
@@ -1368,6 +2671,12 @@ namespace jikoLib{
 
 						void readBuffer(GLenum arg)
 						{
+							if(USE_DSA)
+							{
+								glNamedFramebufferReadBuffer(framebuffer_id, arg);
+								CHECK_GL_ERROR;
+								return;
+							}
 							bind();
 							glReadBuffer(arg);
 							CHECK_GL_ERROR;
@@ -1380,7 +2689,7 @@ namespace jikoLib{
 
 		//renderbuffer
 
-		template<typename TargetType = ReadDrawRenderBuffer, typename Allocator = GLAllocator<Alloc_RenderBuffer>>
+		template<typename TargetType = ReadDrawRenderBuffer, typename Allocator = DefaultAllocator<Alloc_RenderBuffer>>
 			class RenderBuffer{
 				private:
 					GLuint renderbuffer_id;
@@ -1389,13 +2698,15 @@ namespace jikoLib{
 				public:
 					inline void bind() const
 					{
-						glBindRenderbuffer(TargetType::RENDERBUFFER_TARGET, renderbuffer_id);
+						BindState::bindRenderbuffer(renderbuffer_id);
 						CHECK_GL_ERROR;
 					}
 
 					inline void unbind() const
 					{
-						glBindRenderbuffer(TargetType::RENDERBUFFER_TARGET, 0);
+						if(BindState::isLazyUnbind())
+							return;
+						BindState::bindRenderbuffer(0);
 						CHECK_GL_ERROR;
 					}
 
@@ -1403,15 +2714,21 @@ namespace jikoLib{
 					{
 						renderbuffer_id = a.construct();
 						CHECK_GL_ERROR;
-						bind();
+						//glGen* name becomes an object on first bind. glCreate* does not need it
+						if(!USE_DSA)
+						{
+							bind();
+							unbind();
+						}
 						DEBUG_OUT("renderbuffer created! id is " << renderbuffer_id);
-						unbind();
 					}
 
 					~RenderBuffer()
 					{
-						a.destruct(renderbuffer_id);
-						CHECK_GL_ERROR;
+						if(a.destruct(renderbuffer_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						DEBUG_OUT("renderbuffer id " << renderbuffer_id << " destructed!");
 					}
 
@@ -1420,7 +2737,6 @@ namespace jikoLib{
 						this->renderbuffer_id = obj.renderbuffer_id;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("renderbuffer copied! id is " << renderbuffer_id);
 					}
 
@@ -1429,28 +2745,31 @@ namespace jikoLib{
 						this->renderbuffer_id = obj.renderbuffer_id;
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("renderbuffer moved! id is " << renderbuffer_id);
 					}
 
 					RenderBuffer& operator=(const RenderBuffer<TargetType, Allocator> &obj)
 					{
-						a.destruct(renderbuffer_id);
+						if(a.destruct(renderbuffer_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->renderbuffer_id = obj.renderbuffer_id;
 
 						a.copy(obj.a);
-						CHECK_GL_ERROR;
 						DEBUG_OUT("renderbuffer copied! id is " << renderbuffer_id);
 						return *this;
 					}
 
 					RenderBuffer& operator=(RenderBuffer<TargetType, Allocator>&& obj)
 					{
-						a.destruct(renderbuffer_id);
+						if(a.destruct(renderbuffer_id))
+						{
+							CHECK_GL_ERROR;
+						}
 						this->renderbuffer_id = obj.renderbuffer_id;
 
 						a.move(std::move(obj.a));
-						CHECK_GL_ERROR;
 						DEBUG_OUT("renderbuffer moved! id is " << renderbuffer_id);
 						return *this;
 					}
@@ -1460,9 +2779,22 @@ namespace jikoLib{
 						return renderbuffer_id;
 					}
 
+					//name shown in MemoryStats::getLabelBytes()
+					inline void setLabel(const std::string &label) const
+					{
+						MemoryStats::setLabel<Alloc_RenderBuffer>(renderbuffer_id, label);
+					}
+
 					template<typename Format>
 					void storage(int width, int height)
 					{
+						MemoryStats::allocate<Alloc_RenderBuffer>(renderbuffer_id, width*height*Format::BYTES_PER_PIXEL);
+						if(USE_DSA)
+						{
+							glNamedRenderbufferStorage(renderbuffer_id, Format::TEXTURE_COLOR, width, height);
+							CHECK_GL_ERROR;
+							return;
+						}
 						bind();
 						glRenderbufferStorage(TargetType::RENDERBUFFER_TARGET, Format::TEXTURE_COLOR, width, height);
 						CHECK_GL_ERROR;
@@ -1472,17 +2804,694 @@ namespace jikoLib{
 			};
 
 
+
+		//async readback
+
+		//note: AsyncReadback is a future-like token for GPU -> CPU copies. the data goes into a staging
+		//      buffer of its own (glCopyBufferSubData from a VertexBuffer, glReadPixels into
+		//      GL_PIXEL_PACK_BUFFER from a FrameBuffer) followed by a fence. isReady() polls the fence
+		//      with a zero timeout and maps the staging buffer only once it is signaled, so the render
+		//      thread never waits for the GPU. wait() is the blocking variant (for shutdown or tools).
+		//      must be created and polled on the GL thread.
+		template<typename Allocator = DefaultAllocator<Alloc_VertexBuffer>>
+			class AsyncReadback
+			{
+				private:
+					GLuint buffer_id;
+					Allocator a;
+					GLsync fence;
+					std::size_t size;
+					std::vector<GLubyte> result;
+					bool flushed;
+					bool done;
+
+					AsyncReadback(const AsyncReadback &);
+					AsyncReadback& operator=(const AsyncReadback &);
+
+					//staging store, written by the GPU and read once by the CPU
+					void allocate(std::size_t size)
+					{
+						this->size = size;
+						buffer_id = a.construct();
+						if(USE_DSA)
+						{
+							glNamedBufferData(buffer_id, size, NULL, GL_STREAM_READ);
+						}
+						else
+						{
+							BindState::bindBuffer(GL_COPY_WRITE_BUFFER, buffer_id);
+							glBufferData(GL_COPY_WRITE_BUFFER, size, NULL, GL_STREAM_READ);
+						}
+						CHECK_GL_ERROR;
+						MemoryStats::allocate<Alloc_VertexBuffer>(buffer_id, size);
+					}
+
+					inline void insertFence()
+					{
+						fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+						CHECK_GL_ERROR;
+					}
+
+					//copy the staging buffer to result and release the GL objects
+					void fetch()
+					{
+						glDeleteSync(fence);
+						fence = nullptr;
+						const void* ptr;
+						if(USE_DSA)
+						{
+							ptr = glMapNamedBufferRange(buffer_id, 0, size, GL_MAP_READ_BIT);
+						}
+						else
+						{
+							BindState::bindBuffer(GL_COPY_READ_BUFFER, buffer_id);
+							ptr = glMapBufferRange(GL_COPY_READ_BUFFER, 0, size, GL_MAP_READ_BIT);
+						}
+						CHECK_GL_ERROR;
+						if(ptr != nullptr)
+						{
+							result.assign(static_cast<const GLubyte*>(ptr), static_cast<const GLubyte*>(ptr)+size);
+							if(USE_DSA)
+								glUnmapNamedBuffer(buffer_id);
+							else
+								glUnmapBuffer(GL_COPY_READ_BUFFER);
+							CHECK_GL_ERROR;
+						}
+						else
+						{
+							std::cerr << "cannot map readback buffer! --data is empty" << std::endl;
+						}
+						a.destruct(buffer_id);
+						done = true;
+					}
+
+				public:
+					//null token (isReady() is always false)
+					AsyncReadback()
+						:buffer_id(0), fence(nullptr), size(0), flushed(false), done(false) {}
+
+					~AsyncReadback()
+					{
+						if(fence != nullptr)
+							glDeleteSync(fence);
+						if(!done)
+							a.destruct(buffer_id);
+						CHECK_GL_ERROR;
+					}
+
+					AsyncReadback(AsyncReadback<Allocator>&& obj)
+						:buffer_id(obj.buffer_id), fence(obj.fence), size(obj.size), result(std::move(obj.result)), flushed(obj.flushed), done(obj.done)
+					{
+						a.move(std::move(obj.a));
+						obj.fence = nullptr;
+						obj.size = 0;
+						obj.done = false;
+					}
+
+					AsyncReadback& operator=(AsyncReadback<Allocator>&& obj)
+					{
+						if(fence != nullptr)
+							glDeleteSync(fence);
+						if(!done)
+							a.destruct(buffer_id);
+						buffer_id = obj.buffer_id;
+						fence = obj.fence;
+						size = obj.size;
+						result = std::move(obj.result);
+						flushed = obj.flushed;
+						done = obj.done;
+						a.move(std::move(obj.a));
+						obj.fence = nullptr;
+						obj.size = 0;
+						obj.done = false;
+						return *this;
+					}
+
+					//elements [offset, offset+Size_Elem) of buffer (all drawn elements by default)
+					template<typename TargetType, typename UsageType, typename vbAlloc>
+						static AsyncReadback read(const VertexBuffer<TargetType, UsageType, vbAlloc> &buffer, std::size_t offset = 0, std::size_t Size_Elem = static_cast<std::size_t>(-1))
+						{
+							AsyncReadback<Allocator> token;
+							if(!buffer.getisSetArray())
+							{
+								std::cerr << "Array is not set! --did nothing" << std::endl;
+								return token;
+							}
+							Size_Elem = std::min(Size_Elem, buffer.getSizeElem() - std::min(offset, buffer.getSizeElem()));
+							const std::size_t elem_size = buffer.getElemSize();
+							token.allocate(Size_Elem*elem_size);
+							copyBufferSubData(buffer.getID(), token.buffer_id, offset*elem_size, 0, Size_Elem*elem_size);
+							token.insertFence();
+							return token;
+						}
+
+					//glReadPixels of the current read buffer of framebuffer (0 is the default framebuffer).
+					//buffer layout follows the pack state as in a plain glReadPixels
+					//(GL_PACK_ALIGNMENT, GL_PACK_ROW_LENGTH, GL_PACK_SKIP_ROWS and GL_PACK_SKIP_PIXELS)
+					static AsyncReadback readPixels(GLuint framebuffer, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format = GL_RGBA, GLenum type = GL_UNSIGNED_BYTE)
+					{
+						AsyncReadback<Allocator> token;
+						const std::size_t pixel_size = getPixelSize(format, type);
+						if(pixel_size == 0)
+						{
+							std::cerr << "pixel format or type is invalid! --did nothing" << std::endl;
+							return token;
+						}
+						if((width <= 0)||(height <= 0))
+						{
+							std::cerr << "size of area is invalid! --did nothing" << std::endl;
+							return token;
+						}
+						GLint pack_align, row_length, skip_rows, skip_pixels;
+						glGetIntegerv(GL_PACK_ALIGNMENT, &pack_align);
+						glGetIntegerv(GL_PACK_ROW_LENGTH, &row_length);
+						glGetIntegerv(GL_PACK_SKIP_ROWS, &skip_rows);
+						glGetIntegerv(GL_PACK_SKIP_PIXELS, &skip_pixels);
+						//row length 0 means rows are width pixels long
+						const std::size_t row_pixels = (row_length > 0) ? static_cast<std::size_t>(row_length) : static_cast<std::size_t>(width);
+						const std::size_t row = std140_roundup(row_pixels*pixel_size, static_cast<std::size_t>(pack_align));
+						//last row ends at skip_pixels + width, not at the padded row end
+						token.allocate((skip_rows + height - 1)*row + (skip_pixels + width)*pixel_size);
+						const GLuint prev_framebuffer = BindState::getReadFramebuffer();
+						BindState::bindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+						BindState::bindBuffer(GL_PIXEL_PACK_BUFFER, token.buffer_id);
+						glReadPixels(x, y, width, height, format, type, 0);
+						CHECK_GL_ERROR;
+						//never lazy. a bound pack buffer changes the meaning of every later glReadPixels
+						BindState::bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+						BindState::bindFramebuffer(GL_READ_FRAMEBUFFER, prev_framebuffer);
+						token.insertFence();
+						return token;
+					}
+
+					template<typename fbTarget, typename fbAlloc>
+						static AsyncReadback readPixels(const FrameBuffer<fbTarget, fbAlloc> &framebuffer, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format = GL_RGBA, GLenum type = GL_UNSIGNED_BYTE)
+						{
+							return readPixels(framebuffer.getID(), x, y, width, height, format, type);
+						}
+
+					inline bool isNull() const
+					{
+						return (fence == nullptr) && !done;
+					}
+
+					//non-blocking. true once the data is on the CPU
+					bool isReady()
+					{
+						if(done)
+							return true;
+						if(fence == nullptr)
+							return false;
+						//the first poll flushes, so the fence is sure to be submitted
+						GLenum status = glClientWaitSync(fence, flushed ? 0 : GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+						flushed = true;
+						if((status == GL_ALREADY_SIGNALED)||(status == GL_CONDITION_SATISFIED)||(status == GL_WAIT_FAILED))
+							fetch();
+						return done;
+					}
+
+					//blocking. false on timeout (nanoseconds)
+					bool wait(GLuint64 timeout = GL_TIMEOUT_IGNORED)
+					{
+						if(done)
+							return true;
+						if(fence == nullptr)
+							return false;
+						GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+						flushed = true;
+						if(status == GL_TIMEOUT_EXPIRED)
+							return false;
+						fetch();
+						return done;
+					}
+
+					//empty until isReady()
+					inline const std::vector<GLubyte>& getData() const
+					{
+						return result;
+					}
+
+					template<typename T>
+						inline const T* getDataAs() const
+						{
+							return reinterpret_cast<const T*>(result.data());
+						}
+
+					inline std::size_t getSize() const
+					{
+						return size;
+					}
+			};
+
+		//geometry arena
+
+		//range of an arena. indices are relative to base_vertex (drawn with glDrawElementsBaseVertex)
+		struct GeometrySlice
+		{
+			std::size_t base_vertex = 0;
+			std::size_t num_vertex = 0;
+			std::size_t first_index = 0;
+			std::size_t num_index = 0;
+
+			inline bool isNull() const
+			{
+				return num_vertex == 0;
+			}
+			inline bool isIndexed() const
+			{
+				return num_index != 0;
+			}
+		};
+
+		//note: GeometryArena owns one interleaved vertex buffer, one index buffer and one vertex array.
+		//      add() sub-allocates a slice of each from a RangeAllocator and uploads with glBufferSubData,
+		//      remove() returns them. meshes keep a GeometrySlice instead of their own buffers, so the
+		//      attributes are connected once for every mesh of the arena. the store does not grow.
+		template<typename Format = VertexFormatPNT, typename IndexType = GLuint, typename UsageType = StaticDraw>
+			class GeometryArena
+			{
+				static_assert(is_exist<IndexType, GLubyte, GLushort, GLuint>::value, "IBO array type must be GLushort or GLuint or GLubyte");
+
+				private:
+					InterleavedBuffer<Format, UsageType> vertex;
+					VertexBuffer<ElementArrayBuffer, UsageType> index;
+					VertexArray<> v_array;
+					RangeAllocator vertex_range;
+					RangeAllocator index_range;
+
+					bool uploadIndex(GeometrySlice &slice, const IndexType* ind, std::size_t Size_Index)
+					{
+						slice.first_index = index_range.allocate(Size_Index);
+						if(slice.first_index == RangeAllocator::INVALID)
+						{
+							std::cerr << "GeometryArena is out of index space --did nothing" << std::endl;
+							return false;
+						}
+						slice.num_index = Size_Index;
+						index.subData(slice.first_index, ind, Size_Index);
+						return true;
+					}
+
+					template<typename T>
+						bool uploadIndex(GeometrySlice &slice, const T* ind, std::size_t Size_Index)
+						{
+							std::vector<IndexType> converted(ind, ind+Size_Index);
+							return uploadIndex(slice, converted.data(), Size_Index);
+						}
+
+				public:
+					using format_type = Format;
+					using index_type = IndexType;
+
+					GeometryArena(std::size_t Capacity_Vertex, std::size_t Capacity_Index = 0)
+						:vertex_range(Capacity_Vertex), index_range(Capacity_Index)
+					{
+						vertex.allocate(Capacity_Vertex, Capacity_Vertex);
+						if(Capacity_Index != 0)
+							index.template allocate<IndexType>(Capacity_Index, 1, Capacity_Index);
+					}
+
+					GeometryArena(const GeometryArena&) = delete;
+					GeometryArena& operator=(const GeometryArena&) = delete;
+
+					//vertices only (ex. add(numVertex, vert, norm, tex)). returns a null slice when full
+					template<typename... Ts>
+						GeometrySlice add(std::size_t Size_Elem, const Ts*... arrays)
+						{
+							GeometrySlice slice;
+							slice.base_vertex = vertex_range.allocate(Size_Elem);
+							if(slice.base_vertex == RangeAllocator::INVALID)
+							{
+								std::cerr << "GeometryArena is out of vertex space --did nothing" << std::endl;
+								return GeometrySlice();
+							}
+							slice.num_vertex = Size_Elem;
+							vertex.subData(slice.base_vertex, Size_Elem, arrays...);
+							return slice;
+						}
+
+					//indexed. ind may be any unsigned type, it is converted to IndexType
+					template<typename T, typename... Ts>
+						GeometrySlice addIndexed(const T* ind, std::size_t Size_Index, std::size_t Size_Elem, const Ts*... arrays)
+						{
+							static_assert(is_exist<T, GLubyte, GLushort, GLuint>::value, "IBO array type must be GLushort or GLuint or GLubyte");
+							GeometrySlice slice = add(Size_Elem, arrays...);
+							if(slice.isNull())
+								return slice;
+							if(!uploadIndex(slice, ind, Size_Index))
+							{
+								vertex_range.free(slice.base_vertex, slice.num_vertex);
+								return GeometrySlice();
+							}
+							return slice;
+						}
+
+					//the slice is reset to null. other slices keep their offsets
+					void remove(GeometrySlice &slice)
+					{
+						if(slice.isNull())
+							return;
+						vertex_range.free(slice.base_vertex, slice.num_vertex);
+						if(slice.isIndexed())
+							index_range.free(slice.first_index, slice.num_index);
+						slice = GeometrySlice();
+					}
+
+					inline const InterleavedBuffer<Format, UsageType>& getVertex() const
+					{
+						return vertex;
+					}
+					inline const VertexBuffer<ElementArrayBuffer, UsageType>& getIndex() const
+					{
+						return index;
+					}
+					inline const VertexArray<>& getVArray() const
+					{
+						return v_array;
+					}
+
+					inline std::size_t getNumFreeVertex() const
+					{
+						return vertex_range.getNumFree();
+					}
+					inline std::size_t getNumFreeIndex() const
+					{
+						return index_range.getNumFree();
+					}
+			};
+
+		//resource store
+
+		//note: ResourceStore owns plain GL names in dense SlotArrays and hands out 32-bit generational handles.
+		//      records are not ref-counted: copying a handle costs nothing, destroy() deletes the object
+		//      and every copy of the handle becomes stale (get() returns nullptr).
+		//      programs are kept as shared ShaderProg so uniform caches keep working.
+		//      an empty slot holds no program (ShaderProg() would create one).
+		//      all member functions must be called on the GL thread.
+		class ResourceStore
+		{
+			public:
+				struct BufferRecord
+				{
+					GLuint id = 0;
+					GLenum target = 0;
+					GLenum type = 0;
+					std::size_t size_elem = 0;
+					std::size_t dim = 0;
+				};
+
+				struct TextureRecord
+				{
+					GLuint id = 0;
+					GLenum target = 0;
+				};
+
+				struct VertexArrayRecord
+				{
+					GLuint id = 0;
+				};
+
+				struct ProgramRecord
+				{
+					std::shared_ptr<ShaderProg<>> program;
+				};
+
+				using BufferHandle = Handle<BufferRecord>;
+				using TextureHandle = Handle<TextureRecord>;
+				using VertexArrayHandle = Handle<VertexArrayRecord>;
+				using ProgramHandle = Handle<ProgramRecord>;
+
+				struct MeshRecord
+				{
+					VertexArrayHandle varray;
+					BufferHandle vertex;
+					BufferHandle normal;
+					BufferHandle texcrd;
+					BufferHandle index;
+				};
+
+				using MeshHandle = Handle<MeshRecord>;
+
+			private:
+				SlotArray<BufferRecord> buffers;
+				SlotArray<TextureRecord> textures;
+				SlotArray<VertexArrayRecord> varrays;
+				SlotArray<ProgramRecord> programs;
+				SlotArray<MeshRecord> meshes;
+
+				ResourceStore(const ResourceStore &);
+				ResourceStore& operator=(const ResourceStore &);
+
+			public:
+				ResourceStore(){}
+
+				~ResourceStore()
+				{
+					buffers.forEach([](BufferHandle, BufferRecord &r){ GLAllocTraits<Alloc_VertexBuffer>::deallocfunc(r.id); });
+					textures.forEach([](TextureHandle, TextureRecord &r){ GLAllocTraits<Alloc_Texture>::deallocfunc(r.id); });
+					varrays.forEach([](VertexArrayHandle, VertexArrayRecord &r){ GLAllocTraits<Alloc_VertexArray>::deallocfunc(r.id); });
+				}
+
+				//buffer
+
+				template<typename TargetType, typename UsageType = StaticDraw, typename T>
+					BufferHandle createBuffer(const T* array, std::size_t Size_Elem, std::size_t Dim = 1)
+					{
+						static_assert( is_exist<T, GLbyte, GLubyte, GLshort, GLushort, GLint, GLuint, GLfloat, GLdouble>::value, "Invalid type" );
+						static_assert((!std::is_same<TargetType,ElementArrayBuffer>::value)||(is_exist<T,GLubyte,GLushort,GLuint>::value),
+								"IBO array type must be GLushort or GLuint or GLubyte");
+						BufferRecord r;
+						r.id = GLAllocTraits<Alloc_VertexBuffer>::allocfunc();
+						r.target = TargetType::BUFFER_TARGET;
+						r.type = getEnum<T>::value;
+						r.size_elem = Size_Elem;
+						r.dim = Dim;
+						GLsizeiptr size = Size_Elem*Dim*sizeof(T);
+						if(USE_DSA)
+						{
+							glNamedBufferData(r.id, size, array, UsageType::BUFFER_USAGE);
+						}
+						else
+						{
+							//never upload an IBO into a vertex array left bound by lazy unbind
+							if(std::is_same<TargetType, ElementArrayBuffer>::value)
+								BindState::bindVertexArray(0);
+							BindState::bindBuffer(r.target, r.id);
+							glBufferData(r.target, size, array, UsageType::BUFFER_USAGE);
+							if(!BindState::isLazyUnbind())
+								BindState::bindBuffer(r.target, 0);
+						}
+						CHECK_GL_ERROR;
+						MemoryStats::allocate<Alloc_VertexBuffer>(r.id, size);
+						MemoryStats::upload(size);
+						DEBUG_OUT("store buffer created! id is " << r.id);
+						return buffers.insert(r);
+					}
+
+				bool destroy(BufferHandle handle)
+				{
+					const BufferRecord *r = buffers.get(handle);
+					if(r == nullptr)
+						return false;
+					GLAllocTraits<Alloc_VertexBuffer>::deallocfunc(r->id);
+					return buffers.erase(handle);
+				}
+
+				//vertex array
+
+				VertexArrayHandle createVertexArray()
+				{
+					VertexArrayRecord r;
+					r.id = GLAllocTraits<Alloc_VertexArray>::allocfunc();
+					//glGen* name becomes an object on first bind
+					if(!USE_DSA)
+						BindState::bindVertexArray(r.id);
+					CHECK_GL_ERROR;
+					return varrays.insert(r);
+				}
+
+				bool destroy(VertexArrayHandle handle)
+				{
+					const VertexArrayRecord *r = varrays.get(handle);
+					if(r == nullptr)
+						return false;
+					GLAllocTraits<Alloc_VertexArray>::deallocfunc(r->id);
+					return varrays.erase(handle);
+				}
+
+				//texture
+
+				template<typename TargetType, typename TextureType = GLubyte, GLint level = 0, typename int_format = RGBA, typename format = RGBA, typename... Args>
+					TextureHandle createTexture(Args&&... args)
+					{
+						static_assert(is_exist<TargetType, Texture2D, TextureCubeMap>::value, "invalid type");
+						TextureRecord r;
+						r.id = GLAllocTraits<Alloc_Texture>::allocfunc(TargetType::TEXTURE_TARGET);
+						r.target = TargetType::TEXTURE_TARGET;
+						BindState::bindTexture(r.target, r.id);
+						setParameter<Mag_Filter<GL_NEAREST>, Min_Filter<GL_NEAREST>, Wrap_S<GL_CLAMP_TO_EDGE>, Wrap_T<GL_CLAMP_TO_EDGE>, Wrap_R<GL_CLAMP_TO_EDGE>>(r);
+						std::size_t bytes = TextureTraits<TargetType, level, int_format, format, TextureType>::texImage2D(std::forward<Args>(args)...);
+						if(!BindState::isLazyUnbind())
+							BindState::bindTexture(r.target, 0);
+						MemoryStats::allocate<Alloc_Texture>(r.id, bytes);
+						DEBUG_OUT("store texture created! id is " << r.id);
+						return textures.insert(r);
+					}
+
+				template<typename... Args>
+					void setParameter(TextureHandle handle)
+					{
+						const TextureRecord *r = textures.get(handle);
+						if(r == nullptr)
+						{
+							std::cerr << "stale texture handle --did nothing" << std::endl;
+							return;
+						}
+						if(!USE_DSA)
+							BindState::bindTexture(r->target, r->id);
+						setParameter<Args...>(*r);
+					}
+
+				template<typename... Args>
+					static void setParameter(const TextureRecord &r)
+					{
+						SetParamTraits<Args...>::func(r.target, r.id);
+					}
+
+				void bindTexture(TextureHandle handle, std::size_t TexUnitNum = 0) const
+				{
+					const TextureRecord *r = textures.get(handle);
+					if(r == nullptr)
+					{
+						std::cerr << "stale texture handle --did nothing" << std::endl;
+						return;
+					}
+					BindState::activeTexture(TexUnitNum);
+					BindState::bindTexture(r->target, r->id);
+					CHECK_GL_ERROR;
+				}
+
+				bool destroy(TextureHandle handle)
+				{
+					const TextureRecord *r = textures.get(handle);
+					if(r == nullptr)
+						return false;
+					GLAllocTraits<Alloc_Texture>::deallocfunc(r->id);
+					return textures.erase(handle);
+				}
+
+				//program (shares the GL object with the given ShaderProg)
+
+				ProgramHandle addProgram(const ShaderProg<> &program)
+				{
+					ProgramRecord r;
+					r.program = std::make_shared<ShaderProg<>>(program);
+					return programs.insert(r);
+				}
+
+				bool destroy(ProgramHandle handle)
+				{
+					return programs.erase(handle);
+				}
+
+				//mesh
+
+				template<typename T>
+					MeshHandle createMesh(const T *vert, const T *norm, const T *tex, std::size_t Size_Elem)
+					{
+						MeshRecord r;
+						r.varray = createVertexArray();
+						r.vertex = createBuffer<ArrayBuffer>(vert, Size_Elem, 3);
+						if(norm != nullptr)
+							r.normal = createBuffer<ArrayBuffer>(norm, Size_Elem, 3);
+						if(tex != nullptr)
+							r.texcrd = createBuffer<ArrayBuffer>(tex, Size_Elem, 2);
+						return meshes.insert(r);
+					}
+
+				template<typename T, std::size_t Size_Elem>
+					inline MeshHandle createMesh(const T (&vert)[Size_Elem][3], const T (&norm)[Size_Elem][3], const T (&tex)[Size_Elem][2])
+					{
+						return createMesh(&(vert[0][0]), &(norm[0][0]), &(tex[0][0]), Size_Elem);
+					}
+
+				template<typename T>
+					bool setIndex(MeshHandle handle, const T *ind, std::size_t Size_Elem)
+					{
+						MeshRecord *r = meshes.get(handle);
+						if(r == nullptr)
+							return false;
+						destroy(r->index);
+						r->index = createBuffer<ElementArrayBuffer>(ind, Size_Elem);
+						return true;
+					}
+
+				template<typename T, std::size_t Size_Elem>
+					inline bool setIndex(MeshHandle handle, const T (&ind)[Size_Elem])
+					{
+						return setIndex(handle, &(ind[0]), Size_Elem);
+					}
+
+				//also destroys the vertex array and buffers of the mesh
+				bool destroy(MeshHandle handle)
+				{
+					const MeshRecord *r = meshes.get(handle);
+					if(r == nullptr)
+						return false;
+					destroy(r->varray);
+					destroy(r->vertex);
+					destroy(r->normal);
+					destroy(r->texcrd);
+					destroy(r->index);
+					return meshes.erase(handle);
+				}
+
+				//lookup (nullptr if the handle is stale)
+
+				inline const BufferRecord* get(BufferHandle handle) const { return buffers.get(handle); }
+				inline const TextureRecord* get(TextureHandle handle) const { return textures.get(handle); }
+				inline const VertexArrayRecord* get(VertexArrayHandle handle) const { return varrays.get(handle); }
+				inline const ProgramRecord* get(ProgramHandle handle) const { return programs.get(handle); }
+				inline const MeshRecord* get(MeshHandle handle) const { return meshes.get(handle); }
+				inline ProgramRecord* get(ProgramHandle handle) { return programs.get(handle); }
+
+				template<typename Record>
+					inline bool isValid(Handle<Record> handle) const
+					{
+						return get(handle) != nullptr;
+					}
+
+				//func(MeshHandle, const MeshRecord&) for every mesh, in slot order
+				template<typename Func>
+					void forEachMesh(Func func)
+					{
+						meshes.forEach(func);
+					}
+
+				inline std::size_t getNumMeshes() const
+				{
+					return meshes.size();
+				}
+		};
+
 		//some aliases
 		using VShader = Shader<VertexShader>;
 		using GShader = Shader<GeometryShader>;
 		using TCShader = Shader<TessControlShader>;
 		using TEShader = Shader<TessEvalShader>;
 		using FShader = Shader<FragmentShader>;
+		using VShaderCache = ShaderCache<VertexShader>;
+		using GShaderCache = ShaderCache<GeometryShader>;
+		using FShaderCache = ShaderCache<FragmentShader>;
 		using ShaderProgram = ShaderProg<>;
 		using VBO = VertexBuffer<ArrayBuffer, StaticDraw>;
 		using IBO = VertexBuffer<ElementArrayBuffer, StaticDraw>;
+		using UBO = VertexBuffer<UniformBuffer, DynamicDraw>;
+		using DynamicVBO = VertexBuffer<ArrayBuffer, DynamicDraw>;
+		using StreamVBO = VertexBuffer<ArrayBuffer, StreamDraw>;
 		using VAO = VertexArray<>;
 		using FBO = FrameBuffer<>;
 		using RBO = RenderBuffer<>;
+		using Readback = AsyncReadback<>;
 	}
 }
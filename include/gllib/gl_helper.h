@@ -34,9 +34,35 @@
 #include <array>
 #include <type_traits>
 #include <utility>
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <cstdint>
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iterator>
+#include <iostream>
+#include <ctime>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <sys/stat.h>
+#endif
+#include <string>
+#include <unordered_map>
+#include <deque>
+#include <mutex>
+#include <atomic>
 #include <IL/il.h>
 #include <IL/ilu.h>
 #include <cmath>
+#include <limits>
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
 
 
 namespace jikoLib
@@ -225,413 +251,3073 @@ namespace jikoLib
 				(TypeEnum == GL_INT) ? sizeof(GLint) :
 				(TypeEnum == GL_UNSIGNED_INT) ? sizeof(GLuint) :
 				(TypeEnum == GL_FLOAT) ? sizeof(GLfloat) :
-				(TypeEnum == GL_DOUBLE) ? sizeof(GLdouble) : 0;
+				(TypeEnum == GL_DOUBLE) ? sizeof(GLdouble) :
+				(TypeEnum == GL_HALF_FLOAT) ? sizeof(GLhalf) : 0;
 		}
 
+		//bytes of one attribute of Dim components (packed formats hold 4 components in one 32-bit word)
+		constexpr std::size_t getAttribSize(GLenum TypeEnum, std::size_t Dim)
+		{
+			return
+				((TypeEnum == GL_INT_2_10_10_10_REV)||(TypeEnum == GL_UNSIGNED_INT_2_10_10_10_REV)) ? sizeof(GLuint) :
+				Dim*getSizeof(TypeEnum);
+		}
+
+
+		//components of a pixel transfer format (0 if unknown)
+		constexpr std::size_t getPixelComponents(GLenum format)
+		{
+			return
+				((format == GL_RGBA)||(format == GL_BGRA)||(format == GL_RGBA_INTEGER)||(format == GL_BGRA_INTEGER)) ? 4 :
+				((format == GL_RGB)||(format == GL_BGR)||(format == GL_RGB_INTEGER)||(format == GL_BGR_INTEGER)) ? 3 :
+				((format == GL_RG)||(format == GL_RG_INTEGER)||(format == GL_DEPTH_STENCIL)||(format == GL_LUMINANCE_ALPHA)) ? 2 :
+				((format == GL_RED)||(format == GL_GREEN)||(format == GL_BLUE)||(format == GL_ALPHA)||
+				 (format == GL_RED_INTEGER)||(format == GL_GREEN_INTEGER)||(format == GL_BLUE_INTEGER)||
+				 (format == GL_DEPTH_COMPONENT)||(format == GL_STENCIL_INDEX)||(format == GL_LUMINANCE)) ? 1 : 0;
+		}
+
+		//bytes of one pixel of a packed pixel type (0 if not packed)
+		constexpr std::size_t getPackedPixelSize(GLenum type)
+		{
+			return
+				((type == GL_UNSIGNED_BYTE_3_3_2)||(type == GL_UNSIGNED_BYTE_2_3_3_REV)) ? 1 :
+				((type == GL_UNSIGNED_SHORT_5_6_5)||(type == GL_UNSIGNED_SHORT_5_6_5_REV)||
+				 (type == GL_UNSIGNED_SHORT_4_4_4_4)||(type == GL_UNSIGNED_SHORT_4_4_4_4_REV)||
+				 (type == GL_UNSIGNED_SHORT_5_5_5_1)||(type == GL_UNSIGNED_SHORT_1_5_5_5_REV)) ? 2 :
+				((type == GL_UNSIGNED_INT_8_8_8_8)||(type == GL_UNSIGNED_INT_8_8_8_8_REV)||
+				 (type == GL_UNSIGNED_INT_10_10_10_2)||(type == GL_UNSIGNED_INT_2_10_10_10_REV)||
+				 (type == GL_UNSIGNED_INT_24_8)||(type == GL_UNSIGNED_INT_10F_11F_11F_REV)||
+				 (type == GL_UNSIGNED_INT_5_9_9_9_REV)) ? 4 :
+				(type == GL_FLOAT_32_UNSIGNED_INT_24_8_REV) ? 8 : 0;
+		}
+
+		//bytes of one pixel in a pixel transfer (0 if format or type is unknown)
+		constexpr std::size_t getPixelSize(GLenum format, GLenum type)
+		{
+			return
+				(getPixelComponents(format) == 0) ? 0 :
+				(getPackedPixelSize(type) != 0) ? getPackedPixelSize(type) :
+				getPixelComponents(format)*getSizeof(type);
+		}
+
+		//narrowest index type that holds max_index (GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT)
+		constexpr GLenum getIndexEnum(std::size_t max_index)
+		{
+			return
+				(max_index <= 0xff) ? GL_UNSIGNED_BYTE :
+				(max_index <= 0xffff) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		}
+
+
+		/**
+		 * vertex attribute encoding (GLfloat -> compact formats at upload time)
+		 *
+		 */
+
+		//encoding tags for Attrib
+		//GLfloat data stored as 16-bit floats (GL_HALF_FLOAT, GL3.0 or ARB_half_float_vertex)
+		struct HalfFloat{};
+		//3 or 4 GLfloat packed into one 32-bit word (GL_INT_2_10_10_10_REV, GL3.3 or ARB_vertex_type_2_10_10_10_rev)
+		struct Int2_10_10_10_Rev{};
+
+		inline GLhalf floatToHalf(GLfloat value)
+		{
+			std::uint32_t x;
+			std::memcpy(&x, &value, sizeof(x));
+			const std::uint32_t sign = (x >> 16) & 0x8000;
+			const std::uint32_t absx = x & 0x7fffffff;
+			//overflow, inf and nan
+			if(absx >= 0x47800000)
+				return static_cast<GLhalf>(sign | ((absx > 0x7f800000) ? 0x7e00 : 0x7c00));
+			//subnormal half (and zero). unit is 2^-24
+			if(absx < 0x38800000)
+				return static_cast<GLhalf>(sign | static_cast<std::uint32_t>(std::nearbyint(std::fabs(value)*16777216.0f)));
+			//rebias exponent (127 -> 15) and round mantissa to nearest even
+			std::uint32_t h = (absx - 0x38000000) >> 13;
+			const std::uint32_t rem = absx & 0x1fff;
+			if((rem > 0x1000)||((rem == 0x1000)&&(h & 1)))
+				h++;
+			return static_cast<GLhalf>(sign | h);
+		}
+
+		inline void encodeHalf(const GLfloat* src, GLhalf* dst, std::size_t num)
+		{
+			std::size_t i = 0;
+#ifdef __F16C__
+			//4 values per vcvtps2ph
+			for(; i+4 <= num; i+=4)
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst+i), _mm_cvtps_ph(_mm_loadu_ps(src+i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+			for(; i<num; i++)
+				dst[i] = floatToHalf(src[i]);
+		}
+
+		//integer components. normalized: [-1,1] (signed) or [0,1] (unsigned) is mapped to the full range
+		//note: straight loops without branches so that the compiler vectorizes them
+		template<typename T>
+			inline void encodeComponent(const GLfloat* src, T* dst, std::size_t num, bool normalized)
+			{
+				if(std::is_floating_point<T>::value || !normalized)
+				{
+					for(std::size_t i=0; i<num; i++)
+						dst[i] = static_cast<T>(src[i]);
+					return;
+				}
+				//32-bit integers do not fit in a float mantissa
+				using calc_type = typename type_if<(sizeof(T) >= 4), GLdouble, GLfloat>::type;
+				const calc_type lower = std::is_signed<T>::value ? -1 : 0;
+				const calc_type scale = static_cast<calc_type>(std::numeric_limits<T>::max());
+				for(std::size_t i=0; i<num; i++)
+				{
+					const calc_type v = std::min(std::max(static_cast<calc_type>(src[i]), lower), static_cast<calc_type>(1))*scale;
+					dst[i] = static_cast<T>(v + ((v < 0) ? -0.5 : 0.5));
+				}
+			}
+
+		//x in bits 0-9, y 10-19, z 20-29, w 30-31. Dim == 3 leaves w = 0
+		inline void encode2_10_10_10(const GLfloat* src, GLuint* dst, std::size_t Size_Elem, std::size_t Dim, bool normalized)
+		{
+			//xyz: 10-bit signed, w: 2-bit signed
+			const GLfloat scale_xyz = normalized ? 511.0f : 1.0f;
+			const GLfloat limit_xyz = normalized ? 1.0f : 511.0f;
+			for(std::size_t i=0; i<Size_Elem; i++)
+			{
+				GLuint word = 0;
+				for(std::size_t c=0; c<Dim; c++)
+				{
+					const bool is_w = (c == 3);
+					const GLfloat limit = is_w ? 1.0f : limit_xyz;
+					const GLfloat v = std::min(std::max(src[i*Dim+c], -limit), limit)*(is_w ? 1.0f : scale_xyz);
+					const GLint q = static_cast<GLint>(v + ((v < 0.0f) ? -0.5f : 0.5f));
+					word |= (static_cast<GLuint>(q) & (is_w ? 0x3u : 0x3ffu)) << (10*c);
+				}
+				dst[i] = word;
+			}
+		}
+
+
+		/**
+		 * interleaved vertex format
+		 *
+		 */
+
+		//one vertex attribute: component type (or encoding tag), number of components, normalized (integer types only)
+		//value_type is what is stored in the buffer. encode() converts Size_Elem vertices of GLfloat into it.
+		//ex. Attrib<HalfFloat,3> position, Attrib<Int2_10_10_10_Rev,3,true> normal, Attrib<GLushort,2,true> texcoord
+		template<typename T, std::size_t Dim, bool Normalized = false>
+			struct Attrib
+			{
+				static_assert( is_exist<T, GLbyte, GLubyte, GLshort, GLushort, GLint, GLuint, GLfloat, GLdouble>::value, "Invalid type" );
+				static_assert( (Dim != 0)&&(Dim <= 4), "Invalid dimension" );
+				static_assert( (!Normalized)||std::is_integral<T>::value, "only integer attributes can be normalized" );
+				using value_type = T;
+				constexpr static GLenum TYPE = getEnum<T>::value;
+				constexpr static std::size_t DIM = Dim;
+				constexpr static std::size_t SOURCE_DIM = Dim;
+				constexpr static std::size_t NUM_VALUE = Dim;
+				constexpr static GLboolean NORMALIZED = Normalized ? GL_TRUE : GL_FALSE;
+				constexpr static std::size_t SIZE = sizeof(T)*Dim;
+
+				static void encode(const GLfloat* src, value_type* dst, std::size_t Size_Elem)
+				{
+					encodeComponent(src, dst, Size_Elem*Dim, Normalized);
+				}
+			};
+
+		//3 components are stored as 4 (w = 1.0) so that vertices and following attributes stay 4-byte aligned
+		template<std::size_t Dim, bool Normalized>
+			struct Attrib<HalfFloat, Dim, Normalized>
+			{
+				static_assert( (Dim != 0)&&(Dim <= 4), "Invalid dimension" );
+				static_assert( !Normalized, "half float attributes can not be normalized" );
+				using value_type = GLhalf;
+				constexpr static GLenum TYPE = GL_HALF_FLOAT;
+				constexpr static std::size_t DIM = (Dim == 3) ? 4 : Dim;
+				constexpr static std::size_t SOURCE_DIM = Dim;
+				constexpr static std::size_t NUM_VALUE = DIM;
+				constexpr static GLboolean NORMALIZED = GL_FALSE;
+				constexpr static std::size_t SIZE = sizeof(GLhalf)*DIM;
+
+				static void encode(const GLfloat* src, value_type* dst, std::size_t Size_Elem)
+				{
+					if(DIM == SOURCE_DIM)
+					{
+						encodeHalf(src, dst, Size_Elem*Dim);
+						return;
+					}
+					std::vector<GLhalf> packed(Size_Elem*Dim);
+					encodeHalf(src, packed.data(), packed.size());
+					for(std::size_t i=0; i<Size_Elem; i++)
+					{
+						std::memcpy(dst+i*4, packed.data()+i*3, 3*sizeof(GLhalf));
+						dst[i*4+3] = 0x3c00; //1.0
+					}
+				}
+			};
+
+		//always 4 components for GL. Dim is the number of source components (3 or 4)
+		template<std::size_t Dim, bool Normalized>
+			struct Attrib<Int2_10_10_10_Rev, Dim, Normalized>
+			{
+				static_assert( (Dim == 3)||(Dim == 4), "Invalid dimension" );
+				using value_type = GLuint;
+				constexpr static GLenum TYPE = GL_INT_2_10_10_10_REV;
+				constexpr static std::size_t DIM = 4;
+				constexpr static std::size_t SOURCE_DIM = Dim;
+				constexpr static std::size_t NUM_VALUE = 1;
+				constexpr static GLboolean NORMALIZED = Normalized ? GL_TRUE : GL_FALSE;
+				constexpr static std::size_t SIZE = sizeof(GLuint);
+
+				static void encode(const GLfloat* src, value_type* dst, std::size_t Size_Elem)
+				{
+					encode2_10_10_10(src, dst, Size_Elem, Dim, Normalized);
+				}
+			};
+
+		//attributes packed in declaration order. offset(i) and stride() are computed at compile time
+		//ex. VertexFormat<Attrib<GLfloat,3>, Attrib<GLfloat,3>, Attrib<GLfloat,2>> -> stride 32, offsets 0,12,24
+		template<typename... Attribs>
+			struct VertexFormat;
+
+		template<>
+			struct VertexFormat<>
+			{
+				constexpr static std::size_t NUM_ATTRIB = 0;
+				constexpr static std::size_t stride() { return 0; }
+				constexpr static std::size_t offset(std::size_t) { return 0; }
+				constexpr static std::size_t dim(std::size_t) { return 0; }
+				constexpr static GLenum type(std::size_t) { return static_cast<GLenum>(NULL); }
+				constexpr static GLboolean normalized(std::size_t) { return GL_FALSE; }
+
+				static void interleave(GLubyte*, std::size_t, std::size_t) {}
+			};
+
+		template<typename Head, typename... Tail>
+			struct VertexFormat<Head, Tail...>
+			{
+				constexpr static std::size_t NUM_ATTRIB = 1+sizeof...(Tail);
+				constexpr static std::size_t stride() { return Head::SIZE + VertexFormat<Tail...>::stride(); }
+				constexpr static std::size_t offset(std::size_t i) { return (i == 0) ? 0 : Head::SIZE + VertexFormat<Tail...>::offset(i-1); }
+				constexpr static std::size_t dim(std::size_t i) { return (i == 0) ? Head::DIM : VertexFormat<Tail...>::dim(i-1); }
+				constexpr static GLenum type(std::size_t i) { return (i == 0) ? Head::TYPE : VertexFormat<Tail...>::type(i-1); }
+				constexpr static GLboolean normalized(std::size_t i) { return (i == 0) ? Head::NORMALIZED : VertexFormat<Tail...>::normalized(i-1); }
+
+				//scatter one tightly packed array per attribute into dst (Size_Elem vertices of stride() bytes).
+				//an array of the stored type is copied as is, a GLfloat array is encoded first
+				template<typename T, typename... Ts>
+					static void interleave(GLubyte* dst, std::size_t stride, std::size_t Size_Elem, const T* head, const Ts*... tail)
+					{
+						static_assert(std::is_same<T, typename Head::value_type>::value || std::is_same<T, GLfloat>::value,
+								"array type must be the attribute type or GLfloat");
+						scatter(dst, stride, Size_Elem, head);
+						VertexFormat<Tail...>::interleave(dst+Head::SIZE, stride, Size_Elem, tail...);
+					}
+
+			private:
+				static void scatter(GLubyte* dst, std::size_t stride, std::size_t Size_Elem, const typename Head::value_type* src)
+				{
+					for(std::size_t i=0; i<Size_Elem; i++)
+						std::memcpy(dst+i*stride, src+i*Head::NUM_VALUE, Head::SIZE);
+				}
+
+				template<typename T>
+					static void scatter(GLubyte* dst, std::size_t stride, std::size_t Size_Elem, const T* src)
+					{
+						std::vector<typename Head::value_type> encoded(Size_Elem*Head::NUM_VALUE);
+						Head::encode(src, encoded.data(), Size_Elem);
+						scatter(dst, stride, Size_Elem, encoded.data());
+					}
+			};
+
+		//position, normal, texcoord (same data as Mesh3D)
+		using VertexFormatPNT = VertexFormat<Attrib<GLfloat,3>, Attrib<GLfloat,3>, Attrib<GLfloat,2>>;
+		//position, normal
+		using VertexFormatPN = VertexFormat<Attrib<GLfloat,3>, Attrib<GLfloat,3>>;
+		//compact position (half), normal (snorm 2_10_10_10), texcoord (unorm16): 16 bytes instead of 32
+		using VertexFormatPNTCompact = VertexFormat<Attrib<HalfFloat,3>, Attrib<Int2_10_10_10_Rev,3,true>, Attrib<GLushort,2,true>>;
+
+
+		/**
+		 * Simple C++ Node Class
+		 *
+		 */
+
+		template <typename T>
+			struct Node
+			{
+				static_assert(!std::is_pointer<T>::value, "T must not be pointer.");
+				T data;
+				std::vector<Node> child;
+				Node (T newVal)
+					:data(newVal)
+				{}
+				Node(){}
+			};
+
+
+		/**
+		 * generational handle
+		 *
+		 */
+
+		//note: a Handle is a 32-bit (slot index, generation) pair into a SlotArray.
+		//      erasing a slot bumps its generation, so old handles to it are detected as stale.
+		//      generation 0 is never used, so a default-constructed handle is always invalid.
+
+		template<typename Record>
+			class Handle
+			{
+				public:
+					constexpr static std::uint32_t INDEX_BITS = 20;
+					constexpr static std::uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+					constexpr static std::uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+				private:
+					std::uint32_t value;
+
+				public:
+					Handle():value(0){}
+					Handle(std::uint32_t index, std::uint32_t generation)
+						:value((generation << INDEX_BITS) | (index & INDEX_MASK)){}
+
+					inline std::uint32_t getIndex() const
+					{
+						return value & INDEX_MASK;
+					}
+
+					inline std::uint32_t getGeneration() const
+					{
+						return value >> INDEX_BITS;
+					}
+
+					inline bool isNull() const
+					{
+						return value == 0;
+					}
+
+					inline bool operator==(const Handle<Record> &obj) const
+					{
+						return value == obj.value;
+					}
+
+					inline bool operator!=(const Handle<Record> &obj) const
+					{
+						return value != obj.value;
+					}
+			};
+
+		//records live in one vector. freed slots are reused by the next insert
+		template<typename Record>
+			class SlotArray
+			{
+				private:
+					std::vector<Record> records;
+					std::vector<std::uint32_t> generations;
+					std::vector<bool> alive;
+					std::vector<std::uint32_t> free_slots;
+					std::size_t num_alive = 0;
+
+				public:
+					Handle<Record> insert(const Record &record)
+					{
+						std::uint32_t index;
+						if(free_slots.empty())
+						{
+							index = static_cast<std::uint32_t>(records.size());
+							assert(index <= Handle<Record>::INDEX_MASK);
+							records.push_back(record);
+							generations.push_back(1);
+							alive.push_back(true);
+						}
+						else
+						{
+							index = free_slots.back();
+							free_slots.pop_back();
+							records[index] = record;
+							alive[index] = true;
+						}
+						num_alive++;
+						return Handle<Record>(index, generations[index]);
+					}
+
+					inline bool isValid(Handle<Record> handle) const
+					{
+						std::uint32_t index = handle.getIndex();
+						return (index < records.size()) && alive[index] && (generations[index] == handle.getGeneration());
+					}
+
+					//nullptr if the handle is stale
+					inline Record* get(Handle<Record> handle)
+					{
+						return isValid(handle) ? &records[handle.getIndex()] : nullptr;
+					}
+
+					inline const Record* get(Handle<Record> handle) const
+					{
+						return isValid(handle) ? &records[handle.getIndex()] : nullptr;
+					}
+
+					bool erase(Handle<Record> handle)
+					{
+						if(!isValid(handle))
+							return false;
+						std::uint32_t index = handle.getIndex();
+						records[index] = Record();
+						alive[index] = false;
+						//skip generation 0 on wrap around
+						std::uint32_t next = (generations[index] + 1) & Handle<Record>::GENERATION_MASK;
+						generations[index] = (next == 0) ? 1 : next;
+						free_slots.push_back(index);
+						num_alive--;
+						return true;
+					}
+
+					//func(Handle<Record>, Record&) for every live record, in slot order
+					template<typename Func>
+						void forEach(Func func)
+						{
+							for(std::size_t i=0; i<records.size(); i++)
+								if(alive[i])
+									func(Handle<Record>(static_cast<std::uint32_t>(i), generations[i]), records[i]);
+						}
+
+					inline std::size_t size() const
+					{
+						return num_alive;
+					}
+			};
+
+
+		/**
+		 * range allocator
+		 *
+		 */
+
+		//note: RangeAllocator hands out [offset, offset+count) element ranges of a fixed-size store.
+		//      free ranges are kept sorted by offset and merged with their neighbours on free(),
+		//      allocate() is first fit. it owns no memory, only the bookkeeping.
+
+		class RangeAllocator
+		{
+			public:
+				constexpr static std::size_t INVALID = static_cast<std::size_t>(-1);
+
+			private:
+				std::size_t capacity;
+				std::vector<std::pair<std::size_t, std::size_t>> free_list; //(offset, count)
+				std::size_t num_free;
+
+			public:
+				explicit RangeAllocator(std::size_t capacity = 0)
+					:capacity(capacity), num_free(capacity)
+				{
+					if(capacity != 0)
+						free_list.emplace_back(0, capacity);
+				}
+
+				//offset of the range, or INVALID if no free range is large enough
+				std::size_t allocate(std::size_t count)
+				{
+					if(count == 0)
+						return INVALID;
+					for(std::size_t i=0; i<free_list.size(); i++)
+					{
+						if(free_list[i].second < count)
+							continue;
+						std::size_t offset = free_list[i].first;
+						free_list[i].first += count;
+						free_list[i].second -= count;
+						if(free_list[i].second == 0)
+							free_list.erase(free_list.begin()+i);
+						num_free -= count;
+						return offset;
+					}
+					return INVALID;
+				}
+
+				void free(std::size_t offset, std::size_t count)
+				{
+					if((count == 0)||(offset == INVALID))
+						return;
+					assert(offset+count <= capacity);
+					auto next = std::lower_bound(free_list.begin(), free_list.end(), std::make_pair(offset, std::size_t(0)));
+					assert((next == free_list.end())||(offset+count <= next->first));
+					//merge with the following range
+					if((next != free_list.end())&&(offset+count == next->first))
+					{
+						next->first = offset;
+						next->second += count;
+					}
+					else
+					{
+						next = free_list.insert(next, std::make_pair(offset, count));
+					}
+					//merge with the preceding range
+					if(next != free_list.begin())
+					{
+						auto prev = next-1;
+						assert(prev->first+prev->second <= offset);
+						if(prev->first+prev->second == offset)
+						{
+							prev->second += next->second;
+							free_list.erase(next);
+						}
+					}
+					num_free += count;
+				}
+
+				inline std::size_t getCapacity() const
+				{
+					return capacity;
+				}
+
+				inline std::size_t getNumFree() const
+				{
+					return num_free;
+				}
+		};
+
+
+
+		/**
+		 * GLObject Initialize and Finalize destruct
+		 *
+		 */
+
+
+		struct Begin
+		{
+		};
+		/*
+			struct MakeCurrent
+			{
+			SDL_Window* m_window;
+			MakeCurrent(SDL_Window* window):m_window(window){};
+			};
+			struct End{};
+
+*/
+
+
+
+		/**
+		 * direct state access backend
+		 *
+		 */
+
+		// note:
+		// compile with -DGLLIB_USE_DSA (needs GL4.5 or ARB_direct_state_access) to create objects
+		// with glCreate* and edit them through glNamedBufferData, glTextureParameteri,
+		// glNamedFramebufferTexture, etc. objects are then never bound just to be edited.
+		// texture image upload (glTexImage*) has no core DSA form and still binds the texture.
+
+#ifdef GLLIB_USE_DSA
+		constexpr bool USE_DSA = true;
+#else
+		constexpr bool USE_DSA = false;
+#endif
+
+		/**
+		 * bind state cache
+		 *
+		 */
+
+		// note:
+		// the currently bound object of every target (and texture unit) is tracked per thread,
+		// so binding the same object again issues no GL call. call BindState::invalidate()
+		// after binding objects with raw GL calls or switching GL context on the thread.
+		// with lazy unbind, unbind() of buffers, vertex arrays, programs, textures and
+		// renderbuffers does nothing. framebuffers are always unbound (render target matters).
+
+		class BindState
+		{
+			private:
+				constexpr static GLuint UNKNOWN = 0xFFFFFFFF;
+				constexpr static std::size_t MAX_TEXTURE_UNIT = 32;
+
+				struct State
+				{
+					std::unordered_map<GLenum, GLuint> buffers;
+					GLuint vertex_array = UNKNOWN;
+					GLuint program = UNKNOWN;
+					GLuint active_unit = UNKNOWN;
+					std::array<std::unordered_map<GLenum, GLuint>, MAX_TEXTURE_UNIT> textures;
+					GLuint draw_framebuffer = UNKNOWN;
+					GLuint read_framebuffer = UNKNOWN;
+					GLuint renderbuffer = UNKNOWN;
+					std::size_t num_issued = 0;
+					std::size_t num_skipped = 0;
+					bool enabled = true;
+					bool lazy_unbind = false;
+				};
+
+				static State& state()
+				{
+					static thread_local State s;
+					return s;
+				}
+
+				//true if GL call is needed. updates tracked value and counters
+				static inline bool change(GLuint &tracked, GLuint id)
+				{
+					State &s = state();
+					if(s.enabled && (tracked == id))
+					{
+						s.num_skipped++;
+						return false;
+					}
+					tracked = id;
+					s.num_issued++;
+					return true;
+				}
+
+				static inline GLuint& tracked(std::unordered_map<GLenum, GLuint> &map, GLenum target)
+				{
+					return map.emplace(target, static_cast<GLuint>(UNKNOWN)).first->second;
+				}
+
+				//deleted objects are unbound by GL
+				static inline void forget(GLuint &tracked, GLuint id)
+				{
+					if(tracked == id)
+						tracked = 0;
+				}
+
+			public:
+				static inline void setEnabled(bool flag)
+				{
+					state().enabled = flag;
+				}
+
+				static inline bool isEnabled()
+				{
+					return state().enabled;
+				}
+
+				static inline void setLazyUnbind(bool flag)
+				{
+					state().lazy_unbind = flag;
+				}
+
+				static inline bool isLazyUnbind()
+				{
+					return state().lazy_unbind;
+				}
+
+				//forget everything. next bind of every target issues GL call
+				static void invalidate()
+				{
+					State &s = state();
+					s.buffers.clear();
+					s.vertex_array = UNKNOWN;
+					s.program = UNKNOWN;
+					s.active_unit = UNKNOWN;
+					for(auto&& unit : s.textures)
+						unit.clear();
+					s.draw_framebuffer = UNKNOWN;
+					s.read_framebuffer = UNKNOWN;
+					s.renderbuffer = UNKNOWN;
+				}
+
+				static inline void bindBuffer(GLenum target, GLuint id)
+				{
+					if(change(tracked(state().buffers, target), id))
+						glBindBuffer(target, id);
+				}
+
+				//indexed bind also changes generic binding of target
+				static inline void bindBufferBase(GLenum target, GLuint index, GLuint id)
+				{
+					State &s = state();
+					tracked(s.buffers, target) = id;
+					s.num_issued++;
+					glBindBufferBase(target, index, id);
+				}
+
+				static inline void bindBufferRange(GLenum target, GLuint index, GLuint id, GLintptr offset, GLsizeiptr size)
+				{
+					State &s = state();
+					tracked(s.buffers, target) = id;
+					s.num_issued++;
+					glBindBufferRange(target, index, id, offset, size);
+				}
+
+				static inline void bindVertexArray(GLuint id)
+				{
+					State &s = state();
+					if(change(s.vertex_array, id))
+					{
+						glBindVertexArray(id);
+						//element array binding belongs to vertex array
+						s.buffers.erase(GL_ELEMENT_ARRAY_BUFFER);
+					}
+				}
+
+				static inline void useProgram(GLuint id)
+				{
+					if(change(state().program, id))
+						glUseProgram(id);
+				}
+
+				static inline void activeTexture(GLuint unit)
+				{
+					if(change(state().active_unit, unit))
+						glActiveTexture(GL_TEXTURE0 + unit);
+				}
+
+				//bind to active texture unit
+				static inline void bindTexture(GLenum target, GLuint id)
+				{
+					State &s = state();
+					if(s.active_unit >= MAX_TEXTURE_UNIT)
+					{
+						//active unit is unknown
+						s.num_issued++;
+						glBindTexture(target, id);
+						return;
+					}
+					if(change(tracked(s.textures[s.active_unit], target), id))
+						glBindTexture(target, id);
+				}
+
+				static inline void bindFramebuffer(GLenum target, GLuint id)
+				{
+					State &s = state();
+					if(target == GL_FRAMEBUFFER)
+					{
+						if(s.enabled && (s.draw_framebuffer == id) && (s.read_framebuffer == id))
+						{
+							s.num_skipped++;
+							return;
+						}
+						s.draw_framebuffer = s.read_framebuffer = id;
+						s.num_issued++;
+						glBindFramebuffer(target, id);
+					}
+					else if(change((target == GL_DRAW_FRAMEBUFFER) ? s.draw_framebuffer : s.read_framebuffer, id))
+						glBindFramebuffer(target, id);
+				}
+
+				//bound read framebuffer. asks GL if it is not tracked (or tracking is off)
+				static inline GLuint getReadFramebuffer()
+				{
+					State &s = state();
+					if(!s.enabled || (s.read_framebuffer == UNKNOWN))
+					{
+						GLint id = 0;
+						glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &id);
+						s.read_framebuffer = static_cast<GLuint>(id);
+					}
+					return s.read_framebuffer;
+				}
+
+				static inline void bindRenderbuffer(GLuint id)
+				{
+					if(change(state().renderbuffer, id))
+						glBindRenderbuffer(GL_RENDERBUFFER, id);
+				}
+
+				//called on delete
+				static void forgetBuffer(GLuint id)
+				{
+					for(auto&& buffer : state().buffers)
+						forget(buffer.second, id);
+				}
+
+				static void forgetVertexArray(GLuint id)
+				{
+					State &s = state();
+					if(s.vertex_array == id)
+					{
+						s.vertex_array = 0;
+						s.buffers.erase(GL_ELEMENT_ARRAY_BUFFER);
+					}
+				}
+
+				static void forgetTexture(GLuint id)
+				{
+					for(auto&& unit : state().textures)
+						for(auto&& texture : unit)
+							forget(texture.second, id);
+				}
+
+				static void forgetFramebuffer(GLuint id)
+				{
+					forget(state().draw_framebuffer, id);
+					forget(state().read_framebuffer, id);
+				}
+
+				static void forgetRenderbuffer(GLuint id)
+				{
+					forget(state().renderbuffer, id);
+				}
+
+				//counter
+				static inline std::size_t getNumIssued()
+				{
+					return state().num_issued;
+				}
+
+				static inline std::size_t getNumSkipped()
+				{
+					return state().num_skipped;
+				}
+
+				static inline void resetCounter()
+				{
+					state().num_issued = 0;
+					state().num_skipped = 0;
+				}
+		};
+
+		//available alloc type
+		struct Alloc_Shader {};
+		struct Alloc_ShaderProg {};
+		struct Alloc_VertexBuffer {};
+		struct Alloc_VertexArray {};
+		struct Alloc_Texture {};
+		struct Alloc_FrameBuffer {};
+		struct Alloc_RenderBuffer {};
+
+		/**
+		 * GPU memory accounting
+		 */
+
+		//note: MemoryStats records the bytes of every buffer, texture and renderbuffer store,
+		//      keyed by resource type (Alloc_VertexBuffer, Alloc_Texture, Alloc_RenderBuffer) and GL name.
+		//      entries are dropped by the allocator traits when the name is really deleted,
+		//      so shared handles and deferred deletion are counted once.
+		//      sizes are nominal (width*height*bytes per pixel). drivers may pad or compress.
+		class MemoryStats
+		{
+			private:
+				struct Entry
+				{
+					std::size_t bytes = 0;
+					std::size_t mip_bytes = 0;
+					std::string label;
+				};
+
+				struct Table
+				{
+					std::unordered_map<GLuint, Entry> entries;
+					std::size_t live = 0;
+					std::size_t peak = 0;
+				};
+
+				struct Registry
+				{
+					std::mutex mtx;
+					Table buffer;
+					Table texture;
+					Table renderbuffer;
+					std::size_t live = 0;
+					std::size_t peak = 0;
+					std::size_t frame_upload = 0;
+					std::size_t last_frame_upload = 0;
+				};
+
+				static Registry& registry()
+				{
+					static Registry r;
+					return r;
+				}
+
+				template<typename Kind>
+					static Table& table()
+					{
+						static_assert(is_exist<Kind, Alloc_VertexBuffer, Alloc_Texture, Alloc_RenderBuffer>::value, "invalid resource type");
+						Registry &r = registry();
+						return std::is_same<Kind, Alloc_VertexBuffer>::value ? r.buffer :
+							std::is_same<Kind, Alloc_Texture>::value ? r.texture : r.renderbuffer;
+					}
+
+				//replace the size of one entry and update live/peak totals (lock held)
+				static void resize(Table &t, Entry &e, std::size_t bytes, std::size_t mip_bytes)
+				{
+					Registry &r = registry();
+					std::size_t old_size = e.bytes + e.mip_bytes;
+					std::size_t new_size = bytes + mip_bytes;
+					t.live = t.live - old_size + new_size;
+					r.live = r.live - old_size + new_size;
+					t.peak = std::max(t.peak, t.live);
+					r.peak = std::max(r.peak, r.live);
+					e.bytes = bytes;
+					e.mip_bytes = mip_bytes;
+				}
+
+			public:
+				/**
+				 * (re)specify the whole store of an object (glBufferData, level 0 of glTexImage, glRenderbufferStorage)
+				 */
+				template<typename Kind>
+					static void allocate(GLuint id, std::size_t bytes)
+					{
+						std::lock_guard<std::mutex> lock(registry().mtx);
+						Table &t = table<Kind>();
+						resize(t, t.entries[id], bytes, 0);
+					}
+
+				/**
+				 * add a mipmap level uploaded by hand
+				 */
+				template<typename Kind>
+					static void allocateLevel(GLuint id, std::size_t bytes)
+					{
+						std::lock_guard<std::mutex> lock(registry().mtx);
+						Table &t = table<Kind>();
+						Entry &e = t.entries[id];
+						resize(t, e, e.bytes, e.mip_bytes + bytes);
+					}
+
+				/**
+				 * glGenerateMipmap: the full chain is a third of level 0
+				 */
+				template<typename Kind>
+					static void allocateMipmap(GLuint id)
+					{
+						std::lock_guard<std::mutex> lock(registry().mtx);
+						Table &t = table<Kind>();
+						Entry &e = t.entries[id];
+						resize(t, e, e.bytes, e.bytes/3);
+					}
+
+				/**
+				 * bytes sent from the CPU (counted per frame, separate from allocation)
+				 */
+				static void upload(std::size_t bytes)
+				{
+					std::lock_guard<std::mutex> lock(registry().mtx);
+					registry().frame_upload += bytes;
+				}
+
+				//called on delete
+				template<typename Kind>
+					static void forget(GLuint id)
+					{
+						std::lock_guard<std::mutex> lock(registry().mtx);
+						Table &t = table<Kind>();
+						auto it = t.entries.find(id);
+						if(it == t.entries.end())
+							return;
+						resize(t, it->second, 0, 0);
+						t.entries.erase(it);
+					}
+
+				template<typename Kind>
+					static void setLabel(GLuint id, const std::string &label)
+					{
+						std::lock_guard<std::mutex> lock(registry().mtx);
+						table<Kind>().entries[id].label = label;
+					}
+
+				/**
+				 * bytes of live objects (all types, or one type)
+				 */
+				static std::size_t getLiveBytes()
+				{
+					std::lock_guard<std::mutex> lock(registry().mtx);
+					return registry().live;
+				}
+
+				template<typename Kind>
+					static std::size_t getLiveBytes()
+					{
+						std::lock_guard<std::mutex> lock(registry().mtx);
+						return table<Kind>().live;
+					}
+
+				/**
+				 * highest live bytes seen (all types, or one type)
+				 */
+				static std::size_t getPeakBytes()
+				{
+					std::lock_guard<std::mutex> lock(registry().mtx);
+					return registry().peak;
+				}
+
+				template<typename Kind>
+					static std::size_t getPeakBytes()
+					{
+						std::lock_guard<std::mutex> lock(registry().mtx);
+						return table<Kind>().peak;
+					}
+
+				/**
+				 * number of live objects of one type
+				 */
+				template<typename Kind>
+					static std::size_t getNumObjects()
+					{
+						std::lock_guard<std::mutex> lock(registry().mtx);
+						return table<Kind>().entries.size();
+					}
+
+				/**
+				 * live bytes per debug label (unlabeled objects are under "")
+				 */
+				static std::unordered_map<std::string, std::size_t> getLabelBytes()
+				{
+					std::lock_guard<std::mutex> lock(registry().mtx);
+					Registry &r = registry();
+					std::unordered_map<std::string, std::size_t> result;
+					for(const Table *t : {&r.buffer, &r.texture, &r.renderbuffer})
+						for(auto&& e : t->entries)
+							result[e.second.label] += e.second.bytes + e.second.mip_bytes;
+					return result;
+				}
+
+				/**
+				 * bytes uploaded in the current frame and in the last finished frame
+				 */
+				static std::size_t getFrameUploadBytes()
+				{
+					std::lock_guard<std::mutex> lock(registry().mtx);
+					return registry().frame_upload;
+				}
+
+				static std::size_t getLastFrameUploadBytes()
+				{
+					std::lock_guard<std::mutex> lock(registry().mtx);
+					return registry().last_frame_upload;
+				}
+
+				static void endFrame()
+				{
+					std::lock_guard<std::mutex> lock(registry().mtx);
+					Registry &r = registry();
+					r.last_frame_upload = r.frame_upload;
+					r.frame_upload = 0;
+				}
+
+				static void resetPeak()
+				{
+					std::lock_guard<std::mutex> lock(registry().mtx);
+					Registry &r = registry();
+					r.peak = r.live;
+					for(Table *t : {&r.buffer, &r.texture, &r.renderbuffer})
+						t->peak = t->live;
+				}
+		};
+
+
+
+		//alloc traits
+		template<typename T>
+			struct GLAllocTraits{};
+
+		// note:
+		// these traits must have two function objects named "allocfunc" and "deallocfunc".
+		// the return type of allocfunc must be GLuint.
+		// GLPoolAllocator additionally needs "allocfunc_n" and "deallocfunc_n" (n names at once).
+
+		template<>
+			struct GLAllocTraits<Alloc_Shader>
+			{
+				constexpr static auto& allocfunc = glCreateShader; 
+				constexpr static auto& deallocfunc = glDeleteShader; 
+			};
+
+		template<>
+			struct GLAllocTraits<Alloc_ShaderProg>
+			{
+				constexpr static auto& allocfunc = glCreateProgram; 
+				constexpr static auto& deallocfunc = glDeleteProgram; 
+			};
+
+		template<>
+			struct GLAllocTraits<Alloc_VertexBuffer>
+			{
+				static void my_glGenBuffers_n(GLenum, GLsizei n, GLuint* ids)
+				{
+					if(USE_DSA)
+						glCreateBuffers(n, ids);
+					else
+						glGenBuffers(n, ids);
+				}
+
+				static void my_glDeleteBuffers_n(GLsizei n, const GLuint* ids)
+				{
+					glDeleteBuffers(n, ids);
+					for(GLsizei i=0; i<n; i++)
+					{
+						BindState::forgetBuffer(ids[i]);
+						MemoryStats::forget<Alloc_VertexBuffer>(ids[i]);
+					}
+				}
+
+				static GLuint my_glGenBuffers()
+				{
+					GLuint id;
+					my_glGenBuffers_n(0, 1, &id);
+					return id;
+				}
+
+				static void my_glDeleteBuffers(GLuint id)
+				{
+					my_glDeleteBuffers_n(1, &id);
+				}
+
+				using allocfunc_t = GLuint(*)(void);
+				using deallocfunc_t = void(*)(GLuint);
+				using allocfunc_n_t = void(*)(GLenum, GLsizei, GLuint*);
+				using deallocfunc_n_t = void(*)(GLsizei, const GLuint*);
+
+				constexpr static allocfunc_t allocfunc = &my_glGenBuffers; 
+				constexpr static deallocfunc_t deallocfunc = &my_glDeleteBuffers; 
+				constexpr static allocfunc_n_t allocfunc_n = &my_glGenBuffers_n; 
+				constexpr static deallocfunc_n_t deallocfunc_n = &my_glDeleteBuffers_n; 
+			};
+
+		template<>
+			struct GLAllocTraits<Alloc_VertexArray>
+			{
+				static void my_glGenVertexArrays_n(GLenum, GLsizei n, GLuint* ids)
+				{
+					if(USE_DSA)
+						glCreateVertexArrays(n, ids);
+					else
+						glGenVertexArrays(n, ids);
+				}
+
+				static void my_glDeleteVertexArrays_n(GLsizei n, const GLuint* ids)
+				{
+					glDeleteVertexArrays(n, ids);
+					for(GLsizei i=0; i<n; i++)
+						BindState::forgetVertexArray(ids[i]);
+				}
+
+				static GLuint my_glGenVertexArrays()
+				{
+					GLuint id;
+					my_glGenVertexArrays_n(0, 1, &id);
+					return id;
+				}
+
+				static void my_glDeleteVertexArrays(GLuint id)
+				{
+					my_glDeleteVertexArrays_n(1, &id);
+				}
+
+				using allocfunc_t = GLuint(*)(void);
+				using deallocfunc_t = void(*)(GLuint);
+				using allocfunc_n_t = void(*)(GLenum, GLsizei, GLuint*);
+				using deallocfunc_n_t = void(*)(GLsizei, const GLuint*);
+
+				constexpr static allocfunc_t allocfunc = &my_glGenVertexArrays; 
+				constexpr static deallocfunc_t deallocfunc = &my_glDeleteVertexArrays; 
+				constexpr static allocfunc_n_t allocfunc_n = &my_glGenVertexArrays_n; 
+				constexpr static deallocfunc_n_t deallocfunc_n = &my_glDeleteVertexArrays_n; 
+			};
+
+		template<>
+			struct GLAllocTraits<Alloc_Texture>
+			{
+				static void my_glGenTextures_n(GLenum target, GLsizei n, GLuint* ids)
+				{
+					if(USE_DSA)
+						glCreateTextures(target, n, ids);
+					else
+						glGenTextures(n, ids);
+				}
+
+				static void my_glDeleteTextures_n(GLsizei n, const GLuint* ids)
+				{
+					glDeleteTextures(n, ids);
+					for(GLsizei i=0; i<n; i++)
+					{
+						BindState::forgetTexture(ids[i]);
+						MemoryStats::forget<Alloc_Texture>(ids[i]);
+					}
+				}
+
+				//glCreateTextures needs target
+				static GLuint my_glGenTextures(GLenum target)
+				{
+					GLuint id;
+					my_glGenTextures_n(target, 1, &id);
+					return id;
+				}
+
+				static void my_glDeleteTextures(GLuint id)
+				{
+					my_glDeleteTextures_n(1, &id);
+				}
+
+				using allocfunc_t = GLuint(*)(GLenum);
+				using deallocfunc_t = void(*)(GLuint);
+				using allocfunc_n_t = void(*)(GLenum, GLsizei, GLuint*);
+				using deallocfunc_n_t = void(*)(GLsizei, const GLuint*);
+
+				constexpr static allocfunc_t allocfunc = &my_glGenTextures; 
+				constexpr static deallocfunc_t deallocfunc = &my_glDeleteTextures; 
+				constexpr static allocfunc_n_t allocfunc_n = &my_glGenTextures_n; 
+				constexpr static deallocfunc_n_t deallocfunc_n = &my_glDeleteTextures_n; 
+			};
+
+		template<>
+			struct GLAllocTraits<Alloc_FrameBuffer>
+			{
+				static void my_glGenFramebuffers_n(GLenum, GLsizei n, GLuint* ids)
+				{
+					if(USE_DSA)
+						glCreateFramebuffers(n, ids);
+					else
+						glGenFramebuffers(n, ids);
+				}
+
+				static void my_glDeleteFramebuffers_n(GLsizei n, const GLuint* ids)
+				{
+					glDeleteFramebuffers(n, ids);
+					for(GLsizei i=0; i<n; i++)
+						BindState::forgetFramebuffer(ids[i]);
+				}
+
+				static GLuint my_glGenFramebuffers()
+				{
+					GLuint id;
+					my_glGenFramebuffers_n(0, 1, &id);
+					return id;
+				}
+
+				static void my_glDeleteFramebuffers(GLuint id)
+				{
+					my_glDeleteFramebuffers_n(1, &id);
+				}
+
+				using allocfunc_t = GLuint(*)(void);
+				using deallocfunc_t = void(*)(GLuint);
+				using allocfunc_n_t = void(*)(GLenum, GLsizei, GLuint*);
+				using deallocfunc_n_t = void(*)(GLsizei, const GLuint*);
+
+				constexpr static allocfunc_t allocfunc = &my_glGenFramebuffers; 
+				constexpr static deallocfunc_t deallocfunc = &my_glDeleteFramebuffers; 
+				constexpr static allocfunc_n_t allocfunc_n = &my_glGenFramebuffers_n; 
+				constexpr static deallocfunc_n_t deallocfunc_n = &my_glDeleteFramebuffers_n; 
+			};
+
+		template<>
+			struct GLAllocTraits<Alloc_RenderBuffer>
+			{
+				static void my_glGenRenderbuffers_n(GLenum, GLsizei n, GLuint* ids)
+				{
+					if(USE_DSA)
+						glCreateRenderbuffers(n, ids);
+					else
+						glGenRenderbuffers(n, ids);
+				}
+
+				static void my_glDeleteRenderbuffers_n(GLsizei n, const GLuint* ids)
+				{
+					glDeleteRenderbuffers(n, ids);
+					for(GLsizei i=0; i<n; i++)
+					{
+						BindState::forgetRenderbuffer(ids[i]);
+						MemoryStats::forget<Alloc_RenderBuffer>(ids[i]);
+					}
+				}
+
+				static GLuint my_glGenRenderbuffers()
+				{
+					GLuint id;
+					my_glGenRenderbuffers_n(0, 1, &id);
+					return id;
+				}
+
+				static void my_glDeleteRenderbuffers(GLuint id)
+				{
+					my_glDeleteRenderbuffers_n(1, &id);
+				}
+
+				using allocfunc_t = GLuint(*)(void);
+				using deallocfunc_t = void(*)(GLuint);
+				using allocfunc_n_t = void(*)(GLenum, GLsizei, GLuint*);
+				using deallocfunc_n_t = void(*)(GLsizei, const GLuint*);
+
+				constexpr static allocfunc_t allocfunc = &my_glGenRenderbuffers; 
+				constexpr static deallocfunc_t deallocfunc = &my_glDeleteRenderbuffers; 
+				constexpr static allocfunc_n_t allocfunc_n = &my_glGenRenderbuffers_n; 
+				constexpr static deallocfunc_n_t deallocfunc_n = &my_glDeleteRenderbuffers_n; 
+			};
+
+
+		/**
+		 * GLAllocator
+		 *
+		 */
+
+		template<typename T>
+			class GLAllocator
+			{
+				private:
+					int *ref_c;
+					GLAllocator<T>& operator=(const GLAllocator<T> &);
+				public:
+					GLAllocator():ref_c(nullptr){};
+					GLAllocator(const GLAllocator<T> &) = delete;
+
+					template<typename... Args>
+						GLuint construct(Args... args)
+						{
+							ref_c = new int(1);
+							return GLAllocTraits<T>::allocfunc(args...);
+						}
+
+					//true if a GL call was issued
+					template<typename... Args>
+						bool destruct(Args... args)
+						{
+							if((ref_c != nullptr)&&(*ref_c > 0))
+							{
+								(*ref_c)--;
+								if(*ref_c == 0)
+								{
+									GLAllocTraits<T>::deallocfunc(args...);
+									delete ref_c;
+									ref_c = nullptr;
+									return true;
+								}
+							}
+							return false;
+						}
+
+					template<typename Arg_type>
+						void copy(const GLAllocator<Arg_type> &obj)
+						{
+							static_assert( std::is_same<T,Arg_type>::value, "copy with different type!" );
+							ref_c = obj.ref_c;
+							(*ref_c)++;
+						}
+
+					template<typename Arg_type>
+						void move(GLAllocator<Arg_type>&& obj)
+						{
+							static_assert( std::is_same<T,Arg_type>::value, "move with different type!" );
+							ref_c = obj.ref_c;
+							obj.ref_c = nullptr;
+						}
+			};
+
+		/**
+		 * pooled allocator
+		 */
+
+		//note: GLPoolAllocator hands out names from blocks generated with a single glGen*/glCreate* call
+		//      and deletes released names in batches, so creating many small objects costs few GL calls.
+		//      released names are never handed out again (a recycled name would carry stale state).
+		//      reference counts live in a contiguous slab per type instead of one heap int per object.
+		//      released names wait until DELETE_BATCH of them are pending. call GLPoolAllocator<T>::flush()
+		//      once per frame (e.g. after swapping buffers) so they do not linger, and clear() before the
+		//      context is destroyed.
+		template<typename T>
+			class GLPoolAllocator
+			{
+				private:
+					constexpr static GLsizei MIN_BLOCK = 64;
+					constexpr static GLsizei MAX_BLOCK = 1024;
+					constexpr static GLsizei DELETE_BATCH = 64;
+
+					struct Pool
+					{
+						std::vector<int> ref_slab;
+						std::vector<int> free_slot;
+						std::unordered_map<GLenum, std::vector<GLuint>> fresh;
+						std::unordered_map<GLenum, GLsizei> block_size;
+						std::vector<GLuint> released;
+						std::size_t num_glcall = 0;
+					};
+
+					static Pool& pool()
+					{
+						static Pool p;
+						return p;
+					}
+
+					//texture needs its target, the others share key 0
+					static GLenum key(){ return 0; }
+					static GLenum key(GLenum target){ return target; }
+
+					int ref_i;
+					GLPoolAllocator<T>& operator=(const GLPoolAllocator<T> &);
+
+					static GLuint takeName(GLenum k)
+					{
+						Pool& p = pool();
+						std::vector<GLuint>& names = p.fresh[k];
+						if(names.empty())
+						{
+							//geometric growth keeps the number of glGen* calls logarithmic.
+							//capped so a burst does not leave thousands of unused names behind
+							GLsizei& n = p.block_size[k];
+							n = (n == 0) ? MIN_BLOCK : std::min(n*2, MAX_BLOCK);
+							names.resize(n);
+							GLAllocTraits<T>::allocfunc_n(k, n, names.data());
+							p.num_glcall++;
+							std::reverse(names.begin(), names.end());
+						}
+						GLuint id = names.back();
+						names.pop_back();
+						return id;
+					}
+
+					static bool releaseName(GLuint id)
+					{
+						Pool& p = pool();
+						p.released.push_back(id);
+						if(p.released.size() < static_cast<std::size_t>(DELETE_BATCH))
+							return false;
+						flush();
+						return true;
+					}
+
+				public:
+					GLPoolAllocator():ref_i(-1){};
+					GLPoolAllocator(const GLPoolAllocator<T> &) = delete;
+
+					template<typename... Args>
+						GLuint construct(Args... args)
+						{
+							Pool& p = pool();
+							if(p.free_slot.empty())
+							{
+								ref_i = static_cast<int>(p.ref_slab.size());
+								p.ref_slab.push_back(1);
+							}
+							else
+							{
+								ref_i = p.free_slot.back();
+								p.free_slot.pop_back();
+								p.ref_slab[ref_i] = 1;
+							}
+							return takeName(key(args...));
+						}
+
+					//true if a GL call was issued (batch deletion)
+					bool destruct(GLuint id)
+					{
+						Pool& p = pool();
+						if((ref_i >= 0)&&(p.ref_slab[ref_i] > 0))
+						{
+							p.ref_slab[ref_i]--;
+							if(p.ref_slab[ref_i] == 0)
+							{
+								p.free_slot.push_back(ref_i);
+								ref_i = -1;
+								return releaseName(id);
+							}
+						}
+						return false;
+					}
+
+					template<typename Arg_type>
+						void copy(const GLPoolAllocator<Arg_type> &obj)
+						{
+							static_assert( std::is_same<T,Arg_type>::value, "copy with different type!" );
+							ref_i = obj.ref_i;
+							pool().ref_slab[ref_i]++;
+						}
+
+					template<typename Arg_type>
+						void move(GLPoolAllocator<Arg_type>&& obj)
+						{
+							static_assert( std::is_same<T,Arg_type>::value, "move with different type!" );
+							ref_i = obj.ref_i;
+							obj.ref_i = -1;
+						}
+
+					/**
+					 * delete released names now (one GL call)
+					 */
+					static void flush()
+					{
+						Pool& p = pool();
+						if(p.released.empty())
+							return;
+						GLAllocTraits<T>::deallocfunc_n(static_cast<GLsizei>(p.released.size()), p.released.data());
+						p.num_glcall++;
+						p.released.clear();
+					}
+
+					/**
+					 * delete released and never used names (e.g. before destroying the context)
+					 */
+					static void clear()
+					{
+						Pool& p = pool();
+						flush();
+						for(auto&& e : p.fresh)
+						{
+							if(e.second.empty())
+								continue;
+							GLAllocTraits<T>::deallocfunc_n(static_cast<GLsizei>(e.second.size()), e.second.data());
+							p.num_glcall++;
+							e.second.clear();
+						}
+						p.block_size.clear();
+					}
+
+					/**
+					 * number of glGen*, glCreate* and glDelete* calls issued by this pool
+					 */
+					static std::size_t getNumGLCalls()
+					{
+						return pool().num_glcall;
+					}
+			};
+
+		/**
+		 * deferred deletion
+		 */
+
+		//note: RetireQueue keeps dead names until the GPU has finished the frame that retired them.
+		//      retire() only locks a mutex and appends, so it may be called from any thread.
+		//      endFrame() must be called on the GL thread once per frame (after the last draw call).
+		//      it puts a fence after the frame and deletes the names of every frame whose fence has signaled.
+		class RetireQueue
+		{
+			public:
+				using deallocfunc_t = void(*)(GLuint);
+
+			private:
+				struct Retired
+				{
+					deallocfunc_t deallocfunc;
+					GLuint id;
+				};
+
+				struct Frame
+				{
+					GLsync fence;
+					std::vector<Retired> names;
+				};
+
+				struct Queue
+				{
+					std::mutex mtx;
+					std::vector<Retired> pending;
+					std::deque<Frame> frames;
+					std::size_t num_deleted = 0;
+				};
+
+				static Queue& queue()
+				{
+					static Queue q;
+					return q;
+				}
+
+				//delete the names of a frame taken out of the queue
+				static void release(Frame &frame)
+				{
+					for(auto&& e : frame.names)
+						e.deallocfunc(e.id);
+					glDeleteSync(frame.fence);
+				}
+
+				//pop the oldest frame if its fence has signaled (or wait for it).
+				//the wait runs without the lock, so retire() on other threads is never blocked by the GPU
+				static bool popFinished(Frame &frame, GLuint64 timeout)
+				{
+					Queue &q = queue();
+					GLsync fence;
+					{
+						std::lock_guard<std::mutex> lock(q.mtx);
+						if(q.frames.empty())
+							return false;
+						fence = q.frames.front().fence;
+					}
+
+					GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+					//GL_TIMEOUT_EXPIRED or GL_WAIT_FAILED: keep the frame
+					if((result != GL_ALREADY_SIGNALED)&&(result != GL_CONDITION_SATISFIED))
+						return false;
+
+					std::lock_guard<std::mutex> lock(q.mtx);
+					//only the GL thread pops, but do not pop a frame that was not waited for
+					if(q.frames.empty() || (q.frames.front().fence != fence))
+						return false;
+					frame = std::move(q.frames.front());
+					q.frames.pop_front();
+					q.num_deleted += frame.names.size();
+					return true;
+				}
+
+			public:
+				/**
+				 * queue a dead name (any thread)
+				 */
+				static void retire(deallocfunc_t deallocfunc, GLuint id)
+				{
+					Queue &q = queue();
+					std::lock_guard<std::mutex> lock(q.mtx);
+					q.pending.push_back({deallocfunc, id});
+				}
+
+				/**
+				 * fence the current frame and delete the names of finished frames (GL thread)
+				 */
+				static void endFrame()
+				{
+					Queue &q = queue();
+					Frame frame;
+					{
+						std::lock_guard<std::mutex> lock(q.mtx);
+						frame.names.swap(q.pending);
+						if(!frame.names.empty())
+						{
+							frame.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+							q.frames.push_back(std::move(frame));
+						}
+					}
+
+					//fences signal in order, stop at the first busy frame
+					Frame done;
+					while(popFinished(done, 0))
+						release(done);
+				}
+
+				/**
+				 * wait for the GPU and delete every retired name (e.g. before destroying the context)
+				 */
+				static void finish()
+				{
+					endFrame();
+					Frame done;
+					while(popFinished(done, GL_TIMEOUT_IGNORED))
+						release(done);
+				}
+
+				/**
+				 * number of names waiting for deletion
+				 */
+				static std::size_t getNumPending()
+				{
+					Queue &q = queue();
+					std::lock_guard<std::mutex> lock(q.mtx);
+					std::size_t num = q.pending.size();
+					for(auto&& e : q.frames)
+						num += e.names.size();
+					return num;
+				}
+
+				/**
+				 * number of names deleted by this queue
+				 */
+				static std::size_t getNumDeleted()
+				{
+					Queue &q = queue();
+					std::lock_guard<std::mutex> lock(q.mtx);
+					return q.num_deleted;
+				}
+		};
+
+		//note: GLAtomicAllocator lets copies of one object live on several threads.
+		//      the reference count and the name share one control block, made once by construct().
+		//      copy is a relaxed increment. the last destruct (release/acquire) hands the name to
+		//      RetireQueue instead of calling glDelete*, so the thread dropping it needs no GL context.
+		//      as with std::shared_ptr, one handle instance must not be assigned from two threads at once.
+		template<typename T>
+			class GLAtomicAllocator
+			{
+				private:
+					struct Control
+					{
+						std::atomic<int> ref_c;
+						GLuint id;
+					};
+
+					Control *ctrl;
+					GLAtomicAllocator<T>& operator=(const GLAtomicAllocator<T> &);
+				public:
+					GLAtomicAllocator():ctrl(nullptr){};
+					GLAtomicAllocator(const GLAtomicAllocator<T> &) = delete;
+
+					template<typename... Args>
+						GLuint construct(Args... args)
+						{
+							GLuint id = GLAllocTraits<T>::allocfunc(args...);
+							ctrl = new Control{{1}, id};
+							return id;
+						}
+
+					//never issues a GL call
+					bool destruct(GLuint)
+					{
+						if(ctrl == nullptr)
+							return false;
+						if(ctrl->ref_c.fetch_sub(1, std::memory_order_release) == 1)
+						{
+							//every other owner's writes happen before the deletion
+							std::atomic_thread_fence(std::memory_order_acquire);
+							RetireQueue::retire(GLAllocTraits<T>::deallocfunc, ctrl->id);
+							delete ctrl;
+						}
+						ctrl = nullptr;
+						return false;
+					}
+
+					template<typename Arg_type>
+						void copy(const GLAtomicAllocator<Arg_type> &obj)
+						{
+							static_assert( std::is_same<T,Arg_type>::value, "copy with different type!" );
+							ctrl = obj.ctrl;
+							if(ctrl != nullptr)
+								ctrl->ref_c.fetch_add(1, std::memory_order_relaxed);
+						}
+
+					template<typename Arg_type>
+						void move(GLAtomicAllocator<Arg_type>&& obj)
+						{
+							static_assert( std::is_same<T,Arg_type>::value, "move with different type!" );
+							ctrl = obj.ctrl;
+							obj.ctrl = nullptr;
+						}
+
+					/**
+					 * number of handles sharing this object (0 if empty)
+					 */
+					int useCount() const
+					{
+						return (ctrl != nullptr) ? ctrl->ref_c.load(std::memory_order_relaxed) : 0;
+					}
+			};
+
+		//deferred deletion and atomic ref-counting are one policy
+		template<typename T>
+			using GLDeferredAllocator = GLAtomicAllocator<T>;
+
+		//default allocator of batchable objects
+		//(define GLLIB_USE_POOL_ALLOCATOR to switch to GLPoolAllocator, GLLIB_USE_DEFERRED_DELETE to GLDeferredAllocator)
+		template<typename T>
+			struct DefaultAllocTraits
+			{
+				using type = GLAllocator<T>;
+			};
+
+#ifdef GLLIB_USE_POOL_ALLOCATOR
+		template<>
+			struct DefaultAllocTraits<Alloc_VertexBuffer>{ using type = GLPoolAllocator<Alloc_VertexBuffer>; };
+		template<>
+			struct DefaultAllocTraits<Alloc_VertexArray>{ using type = GLPoolAllocator<Alloc_VertexArray>; };
+		template<>
+			struct DefaultAllocTraits<Alloc_Texture>{ using type = GLPoolAllocator<Alloc_Texture>; };
+		template<>
+			struct DefaultAllocTraits<Alloc_FrameBuffer>{ using type = GLPoolAllocator<Alloc_FrameBuffer>; };
+		template<>
+			struct DefaultAllocTraits<Alloc_RenderBuffer>{ using type = GLPoolAllocator<Alloc_RenderBuffer>; };
+#elif defined(GLLIB_USE_DEFERRED_DELETE)
+		template<>
+			struct DefaultAllocTraits<Alloc_VertexBuffer>{ using type = GLDeferredAllocator<Alloc_VertexBuffer>; };
+		template<>
+			struct DefaultAllocTraits<Alloc_VertexArray>{ using type = GLDeferredAllocator<Alloc_VertexArray>; };
+		template<>
+			struct DefaultAllocTraits<Alloc_Texture>{ using type = GLDeferredAllocator<Alloc_Texture>; };
+		template<>
+			struct DefaultAllocTraits<Alloc_FrameBuffer>{ using type = GLDeferredAllocator<Alloc_FrameBuffer>; };
+		template<>
+			struct DefaultAllocTraits<Alloc_RenderBuffer>{ using type = GLDeferredAllocator<Alloc_RenderBuffer>; };
+#endif
+
+		template<typename T>
+			using DefaultAllocator = typename DefaultAllocTraits<T>::type;
+
+		/**
+		 * Shader_type
+		 */
+		struct VertexShader
+		{
+			constexpr static GLenum SHADER_TYPE = GL_VERTEX_SHADER;
+		};
+		struct FragmentShader
+		{
+			constexpr static GLenum SHADER_TYPE = GL_FRAGMENT_SHADER;
+		};
+		struct GeometryShader
+		{
+			constexpr static GLenum SHADER_TYPE = GL_GEOMETRY_SHADER;
+		};
+		struct TessControlShader
+		{
+			constexpr static GLenum SHADER_TYPE = GL_TESS_CONTROL_SHADER;
+		};
+		struct TessEvalShader
+		{
+			constexpr static GLenum SHADER_TYPE = GL_TESS_EVALUATION_SHADER;
+		};
+
+		/**
+		 * "link-these" struct for ShaderProg
+		 */
+
+		struct link_these{};
+
+		/**
+		 * Target_Type for VertexBuffer
+		 */
+
+		struct ArrayBuffer
+		{
+			constexpr static GLenum BUFFER_TARGET = GL_ARRAY_BUFFER;
+		};
+
+		struct ElementArrayBuffer //maybe for IBO
+		{
+			constexpr static GLenum BUFFER_TARGET = GL_ELEMENT_ARRAY_BUFFER;
+		};
+
+		struct UniformBuffer //for UBO
+		{
+			constexpr static GLenum BUFFER_TARGET = GL_UNIFORM_BUFFER;
+		};
+
+		/**
+		 * Usage_Type for VertexBuffer
+		 */
+
+		struct StaticDraw
+		{
+			constexpr static GLenum BUFFER_USAGE = GL_STATIC_DRAW;
+		};
+
+		struct DynamicDraw
+		{
+			constexpr static GLenum BUFFER_USAGE = GL_DYNAMIC_DRAW;
+		};
+
+		struct StreamDraw
+		{
+			constexpr static GLenum BUFFER_USAGE = GL_STREAM_DRAW;
+		};
+
+		struct StaticRead
+		{
+			constexpr static GLenum BUFFER_USAGE = GL_STATIC_READ;
+		};
+
+		struct DynamicRead
+		{
+			constexpr static GLenum BUFFER_USAGE = GL_DYNAMIC_READ;
+		};
+
+		struct StreamRead
+		{
+			constexpr static GLenum BUFFER_USAGE = GL_STREAM_READ;
+		};
+
+		struct StaticCopy
+		{
+			constexpr static GLenum BUFFER_USAGE = GL_STATIC_COPY;
+		};
+
+		struct DynamicCopy
+		{
+			constexpr static GLenum BUFFER_USAGE = GL_DYNAMIC_COPY;
+		};
+
+		struct StreamCopy
+		{
+			constexpr static GLenum BUFFER_USAGE = GL_STREAM_COPY;
+		};
+
+		/**
+		 * std140 layout for UniformBuffer
+		 *
+		 */
+
+		constexpr std::size_t std140_roundup(std::size_t value, std::size_t align)
+		{
+			return (value + align - 1) / align * align;
+		}
+
+		// note:
+		// Std140Traits<T> must have ALIGN (base alignment), SIZE (bytes used by T)
+		// and a static function "write" which copies T into the block.
+		// available member types:
+		//   GLfloat, GLint, GLuint                        scalar
+		//   std::array<scalar, 2..4>                      vec2 .. vec4
+		//   multi_array<GLfloat, C, R>  (C, R = 2..4)     matCxR (column major)
+		//   Std140Array<T, N>                             T[N]
+		//   Std140Layout<...>                             struct
+
+		template<typename T>
+			struct Std140Traits
+			{
+				static_assert(is_exist<T, GLfloat, GLint, GLuint>::value, "invalid std140 member type");
+				constexpr static std::size_t ALIGN = sizeof(T);
+				constexpr static std::size_t SIZE = sizeof(T);
+				static void write(GLubyte* dst, const T &value)
+				{
+					std::memcpy(dst, &value, sizeof(T));
+				}
+			};
+
+		template<typename T, std::size_t N>
+			struct Std140Traits<std::array<T, N>>
+			{
+				static_assert(is_exist<T, GLfloat, GLint, GLuint>::value, "invalid std140 vector type");
+				static_assert((2 <= N)&&(N <= 4), "invalid vector size");
+				//vec3 is aligned like vec4
+				constexpr static std::size_t ALIGN = (N == 2) ? 2*sizeof(T) : 4*sizeof(T);
+				constexpr static std::size_t SIZE = N*sizeof(T);
+				static void write(GLubyte* dst, const std::array<T, N> &value)
+				{
+					std::memcpy(dst, value.data(), N*sizeof(T));
+				}
+			};
+
+		template<std::size_t C, std::size_t R>
+			struct Std140Traits<std::array<std::array<GLfloat, R>, C>>
+			{
+				static_assert((2 <= C)&&(C <= 4)&&(2 <= R)&&(R <= 4), "invalid matrix size");
+				//each column is stored like vec4
+				constexpr static std::size_t ALIGN = 4*sizeof(GLfloat);
+				constexpr static std::size_t SIZE = C*4*sizeof(GLfloat);
+				static void write(GLubyte* dst, const std::array<std::array<GLfloat, R>, C> &value)
+				{
+					for(std::size_t c=0; c<C; c++)
+					{
+						std::memcpy(dst + c*4*sizeof(GLfloat), value[c].data(), R*sizeof(GLfloat));
+					}
+				}
+			};
+
+		template<typename T, std::size_t N>
+			struct Std140Array
+			{
+				std::array<T, N> elem;
+
+				inline T& operator[](std::size_t i)
+				{
+					return elem[i];
+				}
+				inline const T& operator[](std::size_t i) const
+				{
+					return elem[i];
+				}
+			};
+
+		template<typename T, std::size_t N>
+			struct Std140Traits<Std140Array<T, N>>
+			{
+				//array stride is rounded up to vec4
+				constexpr static std::size_t STRIDE = std140_roundup(Std140Traits<T>::SIZE, 16);
+				constexpr static std::size_t ALIGN = 16;
+				constexpr static std::size_t SIZE = STRIDE*N;
+				static void write(GLubyte* dst, const Std140Array<T, N> &value)
+				{
+					for(std::size_t i=0; i<N; i++)
+					{
+						Std140Traits<T>::write(dst + i*STRIDE, value[i]);
+					}
+				}
+			};
+
+		template<typename... Members>
+			class Std140Layout
+			{
+				static_assert(sizeof...(Members) > 0, "Std140Layout needs at least one member");
+
+				public:
+					template<std::size_t I>
+						using member_type = typename std::tuple_element<I, std::tuple<Members...>>::type;
+
+					constexpr static std::size_t offset(std::size_t I)
+					{
+						const std::size_t align[] = {Std140Traits<Members>::ALIGN...};
+						const std::size_t size[] = {Std140Traits<Members>::SIZE...};
+						std::size_t pos = 0;
+						for(std::size_t i=0; i<sizeof...(Members); i++)
+						{
+							pos = std140_roundup(pos, align[i]);
+							if(i == I)
+								return pos;
+							pos += size[i];
+						}
+						return pos;
+					}
+
+					//size of whole block (padded like struct)
+					constexpr static std::size_t SIZE = std140_roundup(offset(sizeof...(Members)), 16);
+
+				private:
+					alignas(16) std::array<GLubyte, SIZE> storage{};
+
+				public:
+					template<std::size_t I>
+						inline void set(const member_type<I> &value)
+						{
+							Std140Traits<member_type<I>>::write(storage.data() + offset(I), value);
+						}
+
+					//vector components (e.g. set<0>(1.0f, 1.0f, 1.0f, 1.0f))
+					template<std::size_t I, typename... Args>
+						inline void set(Args... args)
+						{
+							set<I>(member_type<I>{{args...}});
+						}
+
+					//from raw array (e.g. glm::value_ptr)
+					template<std::size_t I, typename T>
+						inline void setArray(const T* array)
+						{
+							static_assert(is_exist<T, GLfloat, GLint, GLuint>::value, "array type must be GLfloat, GLint or GLuint");
+							static_assert(sizeof(member_type<I>)%sizeof(T) == 0, "member is not an array of T");
+							member_type<I> value;
+							std::memcpy(&value, array, sizeof(value));
+							set<I>(value);
+						}
+
+					inline const GLubyte* data() const
+					{
+						return storage.data();
+					}
+
+					constexpr static std::size_t size()
+					{
+						return SIZE;
+					}
+			};
+
+		template<typename... Members>
+			struct Std140Traits<Std140Layout<Members...>>
+			{
+				constexpr static std::size_t ALIGN = 16;
+				constexpr static std::size_t SIZE = Std140Layout<Members...>::SIZE;
+				static void write(GLubyte* dst, const Std140Layout<Members...> &value)
+				{
+					std::memcpy(dst, value.data(), SIZE);
+				}
+			};
+
+		/**
+		 * setUniform
+		 *
+		 */
+
+		template<std::size_t size, typename Type>
+			struct glUniformXt{};
+		template<>
+			struct glUniformXt<1,GLint>
+			{
+				constexpr static auto& func = glUniform1i;
+			};
+		template<>
+			struct glUniformXt<2,GLint>
+			{
+				constexpr static auto& func = glUniform2i;
+			};
+		template<>
+			struct glUniformXt<3,GLint>
+			{
+				constexpr static auto& func = glUniform3i;
+			};
+		template<>
+			struct glUniformXt<4,GLint>
+			{
+				constexpr static auto& func = glUniform4i;
+			};
+		template<>
+			struct glUniformXt<1,GLfloat>
+			{
+				constexpr static auto& func = glUniform1f;
+			};
+		template<>
+			struct glUniformXt<2,GLfloat>
+			{
+				constexpr static auto& func = glUniform2f;
+			};
+		template<>
+			struct glUniformXt<3,GLfloat>
+			{
+				constexpr static auto& func = glUniform3f;
+			};
+		template<>
+			struct glUniformXt<4,GLfloat>
+			{
+				constexpr static auto& func = glUniform4f;
+			};
+
+
+		template<std::size_t size, typename Type>
+			struct glUniformXtv{};
+		template<>
+			struct glUniformXtv<1,GLint>
+			{
+				constexpr static auto& func = glUniform1iv;
+			};
+		template<>
+			struct glUniformXtv<2,GLint>
+			{
+				constexpr static auto& func = glUniform2iv;
+			};
+		template<>
+			struct glUniformXtv<3,GLint>
+			{
+				constexpr static auto& func = glUniform3iv;
+			};
+		template<>
+			struct glUniformXtv<4,GLint>
+			{
+				constexpr static auto& func = glUniform4iv;
+			};
+		template<>
+			struct glUniformXtv<1,GLfloat>
+			{
+				constexpr static auto& func = glUniform1fv;
+			};
+		template<>
+			struct glUniformXtv<2,GLfloat>
+			{
+				constexpr static auto& func = glUniform2fv;
+			};
+		template<>
+			struct glUniformXtv<3,GLfloat>
+			{
+				constexpr static auto& func = glUniform3fv;
+			};
+		template<>
+			struct glUniformXtv<4,GLfloat>
+			{
+				constexpr static auto& func = glUniform4fv;
+			};
+
+
+		template<std::size_t size, typename Type>
+			struct glUniformMatrixXtv{};
+		template<>
+			struct glUniformMatrixXtv<2,GLfloat>
+			{
+				constexpr static auto& func = glUniformMatrix2fv;
+			};
+		template<>
+			struct glUniformMatrixXtv<3,GLfloat>
+			{
+				constexpr static auto& func = glUniformMatrix3fv;
+			};
+		template<>
+			struct glUniformMatrixXtv<4,GLfloat>
+			{
+				constexpr static auto& func = glUniformMatrix4fv;
+			};
+
+		/**
+		 * setUniform without binding program (glProgramUniform)
+		 *
+		 */
+
+		template<std::size_t size, typename Type>
+			struct glProgramUniformXt{};
+		template<>
+			struct glProgramUniformXt<1,GLint>
+			{
+				constexpr static auto& func = glProgramUniform1i;
+			};
+		template<>
+			struct glProgramUniformXt<2,GLint>
+			{
+				constexpr static auto& func = glProgramUniform2i;
+			};
+		template<>
+			struct glProgramUniformXt<3,GLint>
+			{
+				constexpr static auto& func = glProgramUniform3i;
+			};
+		template<>
+			struct glProgramUniformXt<4,GLint>
+			{
+				constexpr static auto& func = glProgramUniform4i;
+			};
+		template<>
+			struct glProgramUniformXt<1,GLfloat>
+			{
+				constexpr static auto& func = glProgramUniform1f;
+			};
+		template<>
+			struct glProgramUniformXt<2,GLfloat>
+			{
+				constexpr static auto& func = glProgramUniform2f;
+			};
+		template<>
+			struct glProgramUniformXt<3,GLfloat>
+			{
+				constexpr static auto& func = glProgramUniform3f;
+			};
+		template<>
+			struct glProgramUniformXt<4,GLfloat>
+			{
+				constexpr static auto& func = glProgramUniform4f;
+			};
+
+
+		template<std::size_t size, typename Type>
+			struct glProgramUniformXtv{};
+		template<>
+			struct glProgramUniformXtv<1,GLint>
+			{
+				constexpr static auto& func = glProgramUniform1iv;
+			};
+		template<>
+			struct glProgramUniformXtv<2,GLint>
+			{
+				constexpr static auto& func = glProgramUniform2iv;
+			};
+		template<>
+			struct glProgramUniformXtv<3,GLint>
+			{
+				constexpr static auto& func = glProgramUniform3iv;
+			};
+		template<>
+			struct glProgramUniformXtv<4,GLint>
+			{
+				constexpr static auto& func = glProgramUniform4iv;
+			};
+		template<>
+			struct glProgramUniformXtv<1,GLfloat>
+			{
+				constexpr static auto& func = glProgramUniform1fv;
+			};
+		template<>
+			struct glProgramUniformXtv<2,GLfloat>
+			{
+				constexpr static auto& func = glProgramUniform2fv;
+			};
+		template<>
+			struct glProgramUniformXtv<3,GLfloat>
+			{
+				constexpr static auto& func = glProgramUniform3fv;
+			};
+		template<>
+			struct glProgramUniformXtv<4,GLfloat>
+			{
+				constexpr static auto& func = glProgramUniform4fv;
+			};
+
+
+		template<std::size_t size, typename Type>
+			struct glProgramUniformMatrixXtv{};
+		template<>
+			struct glProgramUniformMatrixXtv<2,GLfloat>
+			{
+				constexpr static auto& func = glProgramUniformMatrix2fv;
+			};
+		template<>
+			struct glProgramUniformMatrixXtv<3,GLfloat>
+			{
+				constexpr static auto& func = glProgramUniformMatrix3fv;
+			};
+		template<>
+			struct glProgramUniformMatrixXtv<4,GLfloat>
+			{
+				constexpr static auto& func = glProgramUniformMatrix4fv;
+			};
 
 		/**
-		 * Simple C++ Node Class
+		 * hash (FNV-1a 64bit. stable between runs)
 		 *
 		 */
 
-		template <typename T>
-			struct Node
+		inline std::uint64_t hash_fnv1a(const void* data, std::size_t size, std::uint64_t hash = 14695981039346656037ULL)
+		{
+			const unsigned char* ptr = static_cast<const unsigned char*>(data);
+			for(std::size_t i=0; i<size; i++)
 			{
-				static_assert(!std::is_pointer<T>::value, "T must not be pointer.");
-				T data;
-				std::vector<Node> child;
-				Node (T newVal)
-					:data(newVal)
-				{}
-				Node(){}
-			};
-
+				hash ^= ptr[i];
+				hash *= 1099511628211ULL;
+			}
+			return hash;
+		}
 
+		inline std::uint64_t hash_fnv1a(const std::string &str, std::uint64_t hash = 14695981039346656037ULL)
+		{
+			return hash_fnv1a(str.data(), str.size(), hash);
+		}
 
 		/**
-		 * GLObject Initialize and Finalize destruct
+		 * program binary cache
 		 *
 		 */
 
+		// note:
+		// the cache is disabled until setDirectory() is called. the directory must exist.
+		// while enabled, Shader defers glCompileShader to link time so that a cache hit
+		// skips compilation completely.
 
-		struct Begin
+		class ProgramBinaryCache
 		{
-		};
-		/*
-			struct MakeCurrent
-			{
-			SDL_Window* m_window;
-			MakeCurrent(SDL_Window* window):m_window(window){};
-			};
-			struct End{};
+			private:
+				static std::string& directory()
+				{
+					static std::string dir;
+					return dir;
+				}
 
-*/
+				static std::string getString(GLenum name)
+				{
+					const GLubyte* str = glGetString(name);
+					return (str != nullptr) ? std::string(reinterpret_cast<const char*>(str)) : std::string();
+				}
 
+			public:
+				static void setDirectory(const std::string &dir)
+				{
+					directory() = dir;
+				}
 
+				static inline bool isEnabled()
+				{
+					return !directory().empty();
+				}
 
-		//available alloc type
-		struct Alloc_Shader {};
-		struct Alloc_ShaderProg {};
-		struct Alloc_VertexBuffer {};
-		struct Alloc_VertexArray {};
-		struct Alloc_Texture {};
-		struct Alloc_FrameBuffer {};
-		struct Alloc_RenderBuffer {};
+				//key = attached sources + driver
+				static std::string getPath(std::uint64_t source_hash)
+				{
+					std::uint64_t key = source_hash;
+					key = hash_fnv1a(getString(GL_VENDOR), key);
+					key = hash_fnv1a(getString(GL_RENDERER), key);
+					key = hash_fnv1a(getString(GL_VERSION), key);
+
+					std::ostringstream oss;
+					oss << directory() << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+					return oss.str();
+				}
 
+				static bool load(GLuint program, const std::string &path)
+				{
+					std::ifstream ifs(path, std::ios::binary);
+					if(!ifs)
+						return false;
 
+					GLenum format;
+					ifs.read(reinterpret_cast<char*>(&format), sizeof(format));
+					std::vector<char> binary((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+					if(binary.empty())
+						return false;
 
-		//alloc traits
-		template<typename T>
-			struct GLAllocTraits{};
+					CHECK_GL_ERROR;
+					//note: CHECK_GL_ERROR is empty without DEBUG. drop older errors so they do not look like a rejected binary
+					while(glGetError() != GL_NO_ERROR);
+					glProgramBinary(program, format, binary.data(), binary.size());
+					//unknown format raises GL_INVALID_ENUM. that is just a cache miss
+					if(glGetError() != GL_NO_ERROR)
+					{
+						DEBUG_OUT("program binary " << path << " has unknown format. compile from source");
+						return false;
+					}
 
-		// note:
-		// these traits must have two function objects named "allocfunc" and "deallocfunc".
-		// the return type of allocfunc must be GLuint.
+					GLint linked = GL_FALSE;
+					glGetProgramiv(program, GL_LINK_STATUS, &linked);
+					CHECK_GL_ERROR;
+					if(linked == GL_FALSE)
+					{
+						DEBUG_OUT("program binary " << path << " is rejected. compile from source");
+						return false;
+					}
+					DEBUG_OUT("program binary " << path << " loaded! shaderprog id is " << program);
+					return true;
+				}
 
-		template<>
-			struct GLAllocTraits<Alloc_Shader>
-			{
-				constexpr static auto& allocfunc = glCreateShader; 
-				constexpr static auto& deallocfunc = glDeleteShader; 
-			};
+				static void save(GLuint program, const std::string &path)
+				{
+					GLint length = 0;
+					glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+					CHECK_GL_ERROR;
+					if(length <= 0)
+						return;
 
-		template<>
-			struct GLAllocTraits<Alloc_ShaderProg>
-			{
-				constexpr static auto& allocfunc = glCreateProgram; 
-				constexpr static auto& deallocfunc = glDeleteProgram; 
-			};
+					std::vector<char> binary(length);
+					GLenum format;
+					glGetProgramBinary(program, length, nullptr, &format, binary.data());
+					CHECK_GL_ERROR;
 
-		template<>
-			struct GLAllocTraits<Alloc_VertexBuffer>
-			{
-				static GLuint my_glGenBuffers()
-				{
-					GLuint id;
-					glGenBuffers(1, &id);
-					return id;
+					std::ofstream ofs(path, std::ios::binary);
+					if(!ofs)
+					{
+						std::cerr << "cannot write program binary " << path << std::endl;
+						return;
+					}
+					ofs.write(reinterpret_cast<const char*>(&format), sizeof(format));
+					ofs.write(binary.data(), binary.size());
+					DEBUG_OUT("program binary " << path << " saved! (" << length << " B)");
 				}
+		};
 
-				static void my_glDeleteBuffers(GLuint id)
-				{
-					glDeleteBuffers(1, &id);
-				}
+		/**
+		 * parallel shader compile (KHR_parallel_shader_compile)
+		 *
+		 */
 
-				using allocfunc_t = GLuint(*)(void);
-				using deallocfunc_t = void(*)(GLuint);
+		// note:
+		// while enabled, Shader only submits glCompileShader and ShaderProg only submits
+		// glLinkProgram. status is checked later by ShaderProg::isReady() (or on first use).
+		// without the extension the mode still works, but the first status check blocks.
 
-				constexpr static allocfunc_t allocfunc = &my_glGenBuffers; 
-				constexpr static deallocfunc_t deallocfunc = &my_glDeleteBuffers; 
-			};
+		class ParallelShaderCompile
+		{
+			private:
+				static bool& enabled()
+				{
+					static bool flag = false;
+					return flag;
+				}
 
-		template<>
-			struct GLAllocTraits<Alloc_VertexArray>
-			{
+			public:
+				static inline bool isSupported()
+				{
+					return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+				}
 
-				static GLuint my_glGenVertexArrays()
+				//num_threads = 0xFFFFFFFF means implementation-specific maximum
+				static void setEnabled(bool flag, GLuint num_threads = 0xFFFFFFFF)
 				{
-					GLuint id;
-					glGenVertexArrays(1, &id);
-					return id;
+					enabled() = flag;
+					if(!flag)
+						return;
+
+					if(GLEW_KHR_parallel_shader_compile)
+						glMaxShaderCompilerThreadsKHR(num_threads);
+					else if(GLEW_ARB_parallel_shader_compile)
+						glMaxShaderCompilerThreadsARB(num_threads);
+					else
+					{
+						DEBUG_OUT("parallel shader compile is not supported. compile status is checked lazily");
+					}
+					CHECK_GL_ERROR;
 				}
 
-				static void my_glDeleteVertexArrays(GLuint id)
+				static inline bool isEnabled()
 				{
-					glDeleteVertexArrays(1, &id);
+					return enabled();
 				}
 
-				using allocfunc_t = GLuint(*)(void);
-				using deallocfunc_t = void(*)(GLuint);
+				//enable deferred mode in a scope (compiler threads are not changed)
+				class Scope
+				{
+					private:
+						bool prev;
+					public:
+						Scope():prev(enabled())
+						{
+							enabled() = true;
+						}
+						~Scope()
+						{
+							enabled() = prev;
+						}
+						Scope(const Scope&) = delete;
+						Scope& operator=(const Scope&) = delete;
+				};
+		};
 
-				constexpr static allocfunc_t allocfunc = &my_glGenVertexArrays; 
-				constexpr static deallocfunc_t deallocfunc = &my_glDeleteVertexArrays; 
-			};
+		/**
+		 * shader preprocessor (#include and #define injection)
+		 *
+		 */
 
-		template<>
-			struct GLAllocTraits<Alloc_Texture>
-			{
+		// note:
+		// #include "name" (or <name>) is searched in virtual files, the directory of the
+		// including file, and include directories, in this order. each file is expanded
+		// at most once per source (like #pragma once). defines are sorted by name and
+		// inserted right after the #version line, so the same define set always gives
+		// the same source text.
 
-				static GLuint my_glGenTextures()
+		class ShaderPreprocessor
+		{
+			public:
+				using DefineList = std::vector<std::pair<std::string, std::string>>;
+
+			private:
+				std::vector<std::string> include_dirs;
+				std::unordered_map<std::string, std::string> virtual_files;
+				bool unwrap_raw_string = false;
+
+				static std::string getDirectory(const std::string &path)
 				{
-					GLuint id;
-					glGenTextures(1, &id);
-					return id;
+					auto pos = path.find_last_of('/');
+					return (pos == std::string::npos) ? std::string(".") : path.substr(0, pos);
 				}
 
-				static void my_glDeleteTextures(GLuint id)
+				static bool parseInclude(const std::string &line, std::string &name)
 				{
-					glDeleteTextures(1, &id);
+					std::size_t pos = line.find_first_not_of(" \t");
+					if((pos == std::string::npos) || (line[pos] != '#'))
+						return false;
+					pos = line.find_first_not_of(" \t", pos+1);
+					if((pos == std::string::npos) || (line.compare(pos, 7, "include") != 0))
+						return false;
+					pos = line.find_first_not_of(" \t", pos+7);
+					if((pos == std::string::npos) || ((line[pos] != '"') && (line[pos] != '<')))
+						return false;
+					const char close = (line[pos] == '"') ? '"' : '>';
+					std::size_t end = line.find(close, pos+1);
+					if(end == std::string::npos)
+						return false;
+					name = line.substr(pos+1, end-pos-1);
+					return true;
 				}
 
-				using allocfunc_t = GLuint(*)(void);
-				using deallocfunc_t = void(*)(GLuint);
+				bool findFile(const std::string &name, const std::string &dir, std::string &path, std::string &content) const
+				{
+					auto it = virtual_files.find(name);
+					if(it != virtual_files.end())
+					{
+						path = name;
+						content = it->second;
+						return true;
+					}
 
-				constexpr static allocfunc_t allocfunc = &my_glGenTextures; 
-				constexpr static deallocfunc_t deallocfunc = &my_glDeleteTextures; 
-			};
+					std::vector<std::string> candidates;
+					if(!dir.empty())
+						candidates.push_back(dir + "/" + name);
+					for(auto&& include_dir : include_dirs)
+						candidates.push_back(include_dir + "/" + name);
+					candidates.push_back(name);
 
-		template<>
-			struct GLAllocTraits<Alloc_FrameBuffer>
-			{
-				static GLuint my_glGenFramebuffers()
-				{
-					GLuint id;
-					glGenFramebuffers(1, &id);
-					return id;
+					for(auto&& candidate : candidates)
+					{
+						if(readSource(candidate, content))
+						{
+							path = candidate;
+							return true;
+						}
+					}
+					return false;
 				}
 
-				static void my_glDeleteFramebuffers(GLuint id)
+				void expand(const std::string &source, const std::string &dir, std::vector<std::string> &included, std::string &out) const
 				{
-					glDeleteFramebuffers(1, &id);
+					std::istringstream iss(source);
+					std::string line, name, path, content;
+					while(std::getline(iss, line))
+					{
+						if(!parseInclude(line, name))
+						{
+							out += line;
+							out += '\n';
+							continue;
+						}
+
+						if(!findFile(name, dir, path, content))
+						{
+							std::cerr << "include file " << name << " cannot be found --did nothing" << std::endl;
+							continue;
+						}
+						if(std::find(included.begin(), included.end(), path) != included.end())
+							continue;
+
+						included.push_back(path);
+						expand(content, virtual_files.count(name) ? dir : getDirectory(path), included, out);
+					}
 				}
 
-				using allocfunc_t = GLuint(*)(void);
-				using deallocfunc_t = void(*)(GLuint);
+				bool readSource(const std::string &path, std::string &content) const
+				{
+					if(!readFile(path, content))
+						return false;
+					if(!unwrap_raw_string)
+						return true;
+
+					//strip C++ raw string wrapper R"( ... )"
+					std::size_t begin = content.find_first_not_of(" \t\r\n");
+					if((begin != std::string::npos) && (content.compare(begin, 3, "R\"(") == 0))
+					{
+						std::size_t end = content.rfind(")\"");
+						if((end != std::string::npos) && (end > begin))
+							content = content.substr(begin+3, end-begin-3);
+					}
+					return true;
+				}
 
-				constexpr static allocfunc_t allocfunc = &my_glGenFramebuffers; 
-				constexpr static deallocfunc_t deallocfunc = &my_glDeleteFramebuffers; 
-			};
+			public:
+				static bool readFile(const std::string &path, std::string &content)
+				{
+					std::ifstream ifs(path);
+					if(!ifs)
+						return false;
+					content.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+					return true;
+				}
 
-		template<>
-			struct GLAllocTraits<Alloc_RenderBuffer>
-			{
-				static GLuint my_glGenRenderbuffers()
+				//read files written as C++ raw string literal R"( ... )" (e.g. sources also #included by C++). off by default
+				inline void setUnwrapRawString(bool flag)
 				{
-					GLuint id;
-					glGenRenderbuffers(1, &id);
-					return id;
+					unwrap_raw_string = flag;
 				}
 
-				static void my_glDeleteRenderbuffers(GLuint id)
+				inline void addIncludeDir(const std::string &dir)
 				{
-					glDeleteRenderbuffers(1, &id);
+					include_dirs.push_back(dir);
 				}
 
-				using allocfunc_t = GLuint(*)(void);
-				using deallocfunc_t = void(*)(GLuint);
+				//register in-memory source (e.g. embedded string literal) as an include target
+				inline void addVirtualFile(const std::string &name, const std::string &source)
+				{
+					virtual_files[name] = source;
+				}
 
-				constexpr static allocfunc_t allocfunc = &my_glGenRenderbuffers; 
-				constexpr static deallocfunc_t deallocfunc = &my_glDeleteRenderbuffers; 
-			};
+				//included_files receives every file pulled in by #include (optional)
+				std::string process(const std::string &source, const DefineList &defines = DefineList(), const std::string &dir = std::string(), std::vector<std::string>* included_files = nullptr) const
+				{
+					std::string out;
+					std::vector<std::string> included;
+					expand(source, dir, included, out);
+					if(included_files != nullptr)
+						*included_files = included;
+
+					if(defines.empty())
+						return out;
+
+					DefineList sorted = defines;
+					std::stable_sort(sorted.begin(), sorted.end(),
+							[](const DefineList::value_type &lhs, const DefineList::value_type &rhs){ return lhs.first < rhs.first; });
+
+					std::string define_lines;
+					for(auto&& define : sorted)
+						define_lines += "#define " + define.first + (define.second.empty() ? "" : " " + define.second) + "\n";
+
+					//#version must be the first directive
+					std::size_t pos = out.find("#version");
+					pos = (pos == std::string::npos) ? 0 : out.find('\n', pos);
+					pos = (pos == std::string::npos) ? out.size() : pos+1;
+					out.insert(pos, define_lines);
+					return out;
+				}
 
+				std::string load(const std::string &path, const DefineList &defines = DefineList(), std::vector<std::string>* included_files = nullptr) const
+				{
+					std::string source;
+					if(!readSource(path, source))
+					{
+						std::cerr << "shader file " << path << " cannot be opened" << std::endl;
+						return std::string();
+					}
+					return process(source, defines, getDirectory(path), included_files);
+				}
+		};
 
 		/**
-		 * GLAllocator
+		 * file watcher (inotify on linux, modification time polling elsewhere)
 		 *
 		 */
 
-		template<typename T>
-			class GLAllocator
-			{
-				private:
-					int *ref_c;
-					GLAllocator<T>& operator=(const GLAllocator<T> &);
-				public:
-					GLAllocator():ref_c(nullptr){};
-					GLAllocator(const GLAllocator<T> &) = delete;
+		// note:
+		// on linux the parent directory is watched, because most editors save by
+		// writing a new file and renaming it over the old one.
 
-					template<typename... Args>
-						GLuint construct(Args... args)
-						{
-							ref_c = new int(1);
-							return GLAllocTraits<T>::allocfunc(args...);
-						}
+		class FileWatcher
+		{
+			private:
+				std::vector<std::string> files;
+#ifdef __linux__
+				int fd;
+				std::unordered_map<int, std::string> dirs;
+#else
+				std::vector<std::time_t> mtimes;
+
+				static std::time_t getMTime(const std::string &path)
+				{
+					struct stat st;
+					return (stat(path.c_str(), &st) == 0) ? st.st_mtime : 0;
+				}
+#endif
 
-					template<typename... Args>
-						void destruct(Args... args)
-						{
-							if((ref_c != nullptr)&&(*ref_c > 0))
-							{
-								(*ref_c)--;
-								if(*ref_c == 0)
-								{
-									GLAllocTraits<T>::deallocfunc(args...);
-									delete ref_c;
-									ref_c = nullptr;
-								}
-							}
-						}
+			public:
+#ifdef __linux__
+				FileWatcher()
+				{
+					fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+					if(fd < 0)
+						std::cerr << "inotify_init1 failed. file watcher is disabled" << std::endl;
+				}
 
-					template<typename Arg_type>
-						void copy(const GLAllocator<Arg_type> &obj)
+				~FileWatcher()
+				{
+					if(fd >= 0)
+						close(fd);
+				}
+#else
+				FileWatcher() = default;
+#endif
+
+				FileWatcher(const FileWatcher&) = delete;
+				FileWatcher& operator=(const FileWatcher&) = delete;
+
+				void watch(const std::string &path)
+				{
+					if(std::find(files.begin(), files.end(), path) != files.end())
+						return;
+#ifdef __linux__
+					if(fd < 0)
+						return;
+					auto pos = path.find_last_of('/');
+					std::string dir = (pos == std::string::npos) ? std::string(".") : path.substr(0, pos);
+					int wd = inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+					if(wd < 0)
+					{
+						std::cerr << "cannot watch " << path << " --did nothing" << std::endl;
+						return;
+					}
+					dirs[wd] = dir;
+					files.push_back((pos == std::string::npos) ? "./" + path : path);
+#else
+					files.push_back(path);
+					mtimes.push_back(getMTime(path));
+#endif
+					DEBUG_OUT("watching " << path);
+				}
+
+				//changed files since the last call. never blocks
+				std::vector<std::string> poll()
+				{
+					std::vector<std::string> changed;
+#ifdef __linux__
+					if(fd < 0)
+						return changed;
+					alignas(struct inotify_event) char buf[4096];
+					ssize_t len;
+					while((len = read(fd, buf, sizeof(buf))) > 0)
+					{
+						for(char* ptr = buf; ptr < buf+len; ptr += sizeof(struct inotify_event) + reinterpret_cast<struct inotify_event*>(ptr)->len)
 						{
-							static_assert( std::is_same<T,Arg_type>::value, "copy with different type!" );
-							ref_c = obj.ref_c;
-							(*ref_c)++;
+							auto event = reinterpret_cast<struct inotify_event*>(ptr);
+							if((event->len == 0) || (dirs.count(event->wd) == 0))
+								continue;
+							std::string path = dirs[event->wd] + "/" + event->name;
+							if((std::find(files.begin(), files.end(), path) != files.end()) &&
+									(std::find(changed.begin(), changed.end(), path) == changed.end()))
+								changed.push_back(path);
 						}
-
-					template<typename Arg_type>
-						void move(GLAllocator<Arg_type>&& obj)
+					}
+#else
+					for(std::size_t i=0; i<files.size(); i++)
+					{
+						std::time_t mtime = getMTime(files[i]);
+						if(mtime != mtimes[i])
 						{
-							static_assert( std::is_same<T,Arg_type>::value, "move with different type!" );
-							ref_c = obj.ref_c;
-							obj.ref_c = nullptr;
+							mtimes[i] = mtime;
+							changed.push_back(files[i]);
 						}
-			};
+					}
+#endif
+					return changed;
+				}
+		};
 
 		/**
-		 * Shader_type
+		 * program reflection (built at link time)
+		 *
 		 */
-		struct VertexShader
-		{
-			constexpr static GLenum SHADER_TYPE = GL_VERTEX_SHADER;
-		};
-		struct FragmentShader
+
+		struct UniformInfo
 		{
-			constexpr static GLenum SHADER_TYPE = GL_FRAGMENT_SHADER;
+			std::string name;
+			GLenum type;
+			GLint size;
+			GLint location;     //-1 for block members
+			GLint offset;       //-1 outside of blocks
+			GLint block_index;  //-1 outside of blocks
 		};
-		struct GeometryShader
+
+		struct UniformBlockInfo
 		{
-			constexpr static GLenum SHADER_TYPE = GL_GEOMETRY_SHADER;
+			std::string name;
+			GLuint index;
+			GLint data_size;
+			GLint binding;
 		};
-		struct TessControlShader
+
+		struct AttribInfo
 		{
-			constexpr static GLenum SHADER_TYPE = GL_TESS_CONTROL_SHADER;
+			std::string name;
+			GLenum type;
+			GLint size;
+			GLint location;
 		};
-		struct TessEvalShader
+
+		class ProgramReflection
 		{
-			constexpr static GLenum SHADER_TYPE = GL_TESS_EVALUATION_SHADER;
-		};
+			private:
+				std::vector<UniformInfo> uniforms;
+				std::vector<UniformBlockInfo> blocks;
+				std::vector<AttribInfo> attributes;
 
-		/**
-		 * "link-these" struct for ShaderProg
-		 */
+				std::unordered_map<std::string, std::size_t> uniform_indices;
+				std::unordered_map<std::string, std::size_t> block_indices;
+				std::unordered_map<std::string, std::size_t> attrib_indices;
 
-		struct link_these{};
+				template<typename T>
+					static const T* findIn(const std::vector<T> &vec, const std::unordered_map<std::string, std::size_t> &indices, const std::string &name)
+					{
+						auto it = indices.find(name);
+						return (it != indices.end()) ? &vec[it->second] : nullptr;
+					}
 
-		/**
-		 * Target_Type for VertexBuffer
-		 */
+				static std::string getName(const std::vector<GLchar> &buf, GLsizei len)
+				{
+					return std::string(buf.data(), len);
+				}
 
-		struct ArrayBuffer
-		{
-			constexpr static GLenum BUFFER_TARGET = GL_ARRAY_BUFFER;
-		};
+			public:
+				void build(GLuint program)
+				{
+					clear();
 
-		struct ElementArrayBuffer //maybe for IBO
-		{
-			constexpr static GLenum BUFFER_TARGET = GL_ELEMENT_ARRAY_BUFFER;
+					GLint num = 0, max_len = 0;
+					std::vector<GLchar> buf;
+
+					//uniforms
+					glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &num);
+					CHECK_GL_ERROR;
+					glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_len);
+					CHECK_GL_ERROR;
+					buf.resize(max_len > 0 ? max_len : 1);
+					for(GLint i=0; i<num; i++)
+					{
+						UniformInfo info;
+						GLsizei len = 0;
+						GLuint index = i;
+						glGetActiveUniform(program, index, buf.size(), &len, &info.size, &info.type, buf.data());
+						CHECK_GL_ERROR;
+						info.name = getName(buf, len);
+						glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_OFFSET, &info.offset);
+						CHECK_GL_ERROR;
+						glGetActiveUniformsiv(program, 1, &index, GL_UNIFORM_BLOCK_INDEX, &info.block_index);
+						CHECK_GL_ERROR;
+						info.location = -1;
+						if(info.block_index == -1)
+						{
+							info.location = glGetUniformLocation(program, info.name.c_str());
+							CHECK_GL_ERROR;
+						}
+						uniform_indices[info.name] = uniforms.size();
+						//"arr[0]" is also accessible as "arr"
+						if((info.name.size() > 3)&&(info.name.compare(info.name.size()-3, 3, "[0]") == 0))
+							uniform_indices[info.name.substr(0, info.name.size()-3)] = uniforms.size();
+						uniforms.push_back(std::move(info));
+					}
+
+					//uniform blocks
+					glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &num);
+					CHECK_GL_ERROR;
+					glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_len);
+					CHECK_GL_ERROR;
+					buf.resize(max_len > 0 ? max_len : 1);
+					for(GLint i=0; i<num; i++)
+					{
+						UniformBlockInfo info;
+						GLsizei len = 0;
+						info.index = i;
+						glGetActiveUniformBlockName(program, info.index, buf.size(), &len, buf.data());
+						CHECK_GL_ERROR;
+						info.name = getName(buf, len);
+						glGetActiveUniformBlockiv(program, info.index, GL_UNIFORM_BLOCK_DATA_SIZE, &info.data_size);
+						CHECK_GL_ERROR;
+						glGetActiveUniformBlockiv(program, info.index, GL_UNIFORM_BLOCK_BINDING, &info.binding);
+						CHECK_GL_ERROR;
+						block_indices[info.name] = blocks.size();
+						blocks.push_back(std::move(info));
+					}
+
+					//attributes
+					glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &num);
+					CHECK_GL_ERROR;
+					glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &max_len);
+					CHECK_GL_ERROR;
+					buf.resize(max_len > 0 ? max_len : 1);
+					for(GLint i=0; i<num; i++)
+					{
+						AttribInfo info;
+						GLsizei len = 0;
+						glGetActiveAttrib(program, i, buf.size(), &len, &info.size, &info.type, buf.data());
+						CHECK_GL_ERROR;
+						info.name = getName(buf, len);
+						info.location = glGetAttribLocation(program, info.name.c_str());
+						CHECK_GL_ERROR;
+						if(info.location == -1)
+							continue; //built-in (gl_VertexID etc.)
+						attrib_indices[info.name] = attributes.size();
+						attributes.push_back(std::move(info));
+					}
+
+					DEBUG_OUT("reflection built! "
+							<< uniforms.size() << " uniforms, "
+							<< blocks.size() << " blocks, "
+							<< attributes.size() << " attributes. shaderprog id is " << program);
+				}
+
+				inline void clear()
+				{
+					uniforms.clear();
+					blocks.clear();
+					attributes.clear();
+					uniform_indices.clear();
+					block_indices.clear();
+					attrib_indices.clear();
+				}
+
+				inline const UniformInfo* findUniform(const std::string &name) const
+				{
+					return findIn(uniforms, uniform_indices, name);
+				}
+
+				inline const UniformBlockInfo* findUniformBlock(const std::string &name) const
+				{
+					return findIn(blocks, block_indices, name);
+				}
+
+				inline const AttribInfo* findAttrib(const std::string &name) const
+				{
+					return findIn(attributes, attrib_indices, name);
+				}
+
+				inline void setUniformBlockBinding(GLuint index, GLint binding)
+				{
+					if(index < blocks.size())
+						blocks[index].binding = binding;
+				}
+
+				inline const std::vector<UniformInfo>& getUniforms() const
+				{
+					return uniforms;
+				}
+
+				inline const std::vector<UniformBlockInfo>& getUniformBlocks() const
+				{
+					return blocks;
+				}
+
+				inline const std::vector<AttribInfo>& getAttribs() const
+				{
+					return attributes;
+				}
 		};
 
 		/**
-		 * Usage_Type for VertexBuffer
+		 * uniform handle
+		 *
 		 */
 
-		struct StaticDraw
+		struct UniformHandle
 		{
-			constexpr static GLenum BUFFER_USAGE = GL_STATIC_DRAW;
+			GLuint program = 0;
+			GLint location = -1;
+			std::size_t index = static_cast<std::size_t>(-1);
+
+			inline bool isValid() const
+			{
+				return location != -1;
+			}
 		};
 
 		/**
-		 * setUniform
+		 * uniform location table
 		 *
 		 */
 
-		template<std::size_t size, typename Type>
-			struct glUniformXt{};
-		template<>
-			struct glUniformXt<1,GLint>
-			{
-				constexpr static auto& func = glUniform1i;
-			};
-		template<>
-			struct glUniformXt<2,GLint>
-			{
-				constexpr static auto& func = glUniform2i;
-			};
-		template<>
-			struct glUniformXt<3,GLint>
-			{
-				constexpr static auto& func = glUniform3i;
-			};
-		template<>
-			struct glUniformXt<4,GLint>
-			{
-				constexpr static auto& func = glUniform4i;
-			};
-		template<>
-			struct glUniformXt<1,GLfloat>
-			{
-				constexpr static auto& func = glUniform1f;
-			};
-		template<>
-			struct glUniformXt<2,GLfloat>
-			{
-				constexpr static auto& func = glUniform2f;
-			};
-		template<>
-			struct glUniformXt<3,GLfloat>
-			{
-				constexpr static auto& func = glUniform3f;
-			};
-		template<>
-			struct glUniformXt<4,GLfloat>
-			{
-				constexpr static auto& func = glUniform4f;
-			};
+		//note:
+		//the table keeps the last value sent to each non-array uniform and skips the upload
+		//when the same bytes are set again. values written by raw glUniform* calls are not seen.
+		//handles must be looked up again after relink.
 
+		class UniformTable
+		{
+			public:
+				constexpr static std::size_t npos = static_cast<std::size_t>(-1);
 
-		template<std::size_t size, typename Type>
-			struct glUniformXtv{};
-		template<>
-			struct glUniformXtv<1,GLint>
-			{
-				constexpr static auto& func = glUniform1iv;
-			};
-		template<>
-			struct glUniformXtv<2,GLint>
-			{
-				constexpr static auto& func = glUniform2iv;
-			};
-		template<>
-			struct glUniformXtv<3,GLint>
-			{
-				constexpr static auto& func = glUniform3iv;
-			};
-		template<>
-			struct glUniformXtv<4,GLint>
-			{
-				constexpr static auto& func = glUniform4iv;
-			};
-		template<>
-			struct glUniformXtv<1,GLfloat>
-			{
-				constexpr static auto& func = glUniform1fv;
-			};
-		template<>
-			struct glUniformXtv<2,GLfloat>
-			{
-				constexpr static auto& func = glUniform2fv;
-			};
-		template<>
-			struct glUniformXtv<3,GLfloat>
-			{
-				constexpr static auto& func = glUniform3fv;
-			};
-		template<>
-			struct glUniformXtv<4,GLfloat>
-			{
-				constexpr static auto& func = glUniform4fv;
-			};
+			private:
+				struct Entry
+				{
+					GLint location;
+					bool shadowed;
+					std::vector<GLubyte> value;
+				};
 
+				std::unordered_map<std::string, std::size_t> indices;
+				std::vector<Entry> entries;
+
+				std::size_t num_issued = 0;
+				std::size_t num_skipped = 0;
+
+				std::size_t add(GLint location, bool shadowed)
+				{
+					entries.push_back(Entry{location, shadowed, std::vector<GLubyte>()});
+					return entries.size()-1;
+				}
+
+			public:
+				//fill from reflection (call after link)
+				void build(const ProgramReflection &reflection)
+				{
+					indices.clear();
+					entries.clear();
+
+					for(auto&& info : reflection.getUniforms())
+					{
+						if(info.location == -1)
+							continue; //member of uniform block
+
+						//arrays are not shadowed: "arr[1]" can alias part of "arr"
+						std::size_t index = add(info.location, info.size == 1);
+						indices[info.name] = index;
+						//"arr[0]" is also accessible as "arr"
+						if((info.name.size() > 3)&&(info.name.compare(info.name.size()-3, 3, "[0]") == 0))
+							indices[info.name.substr(0, info.name.size()-3)] = index;
+					}
+					DEBUG_OUT("uniform table built! " << entries.size() << " entries.");
+				}
+
+				std::size_t find(GLuint program, const std::string &name)
+				{
+					auto it = indices.find(name);
+					if(it != indices.end())
+						return it->second;
+
+					//not enumerated (e.g. "arr[2]"). ask once and remember
+					GLint loc = glGetUniformLocation(program, name.c_str());
+					CHECK_GL_ERROR;
+					std::size_t index = add(loc, false);
+					indices.emplace(name, index);
+					return index;
+				}
+
+				inline GLint getLocation(std::size_t index) const
+				{
+					return (index < entries.size()) ? entries[index].location : -1;
+				}
+
+				//returns false if the upload can be skipped
+				bool update(std::size_t index, const void* data, std::size_t bytes)
+				{
+					Entry &entry = entries[index];
+					if(entry.shadowed)
+					{
+						const GLubyte* ptr = static_cast<const GLubyte*>(data);
+						if((entry.value.size() == bytes)&&(std::equal(ptr, ptr+bytes, entry.value.begin())))
+						{
+							num_skipped++;
+							return false;
+						}
+						entry.value.assign(ptr, ptr+bytes);
+					}
+					num_issued++;
+					return true;
+				}
+
+				inline std::size_t getNumIssued() const
+				{
+					return num_issued;
+				}
+
+				inline std::size_t getNumSkipped() const
+				{
+					return num_skipped;
+				}
+
+				inline void resetCounter()
+				{
+					num_issued = 0;
+					num_skipped = 0;
+				}
+		};
 
-		template<std::size_t size, typename Type>
-			struct glUniformMatrixXtv{};
-		template<>
-			struct glUniformMatrixXtv<2,GLfloat>
-			{
-				constexpr static auto& func = glUniformMatrix2fv;
-			};
-		template<>
-			struct glUniformMatrixXtv<3,GLfloat>
-			{
-				constexpr static auto& func = glUniformMatrix3fv;
-			};
-		template<>
-			struct glUniformMatrixXtv<4,GLfloat>
-			{
-				constexpr static auto& func = glUniformMatrix4fv;
-			};
 
 		/**
 		 * render mode
@@ -731,6 +3417,7 @@ namespace jikoLib
 			constexpr static GLenum TEXTURE_COLOR = GL_RGB;
 			constexpr static std::size_t ALIGN = 1;
 			constexpr static ILenum IL_COLOR = IL_RGB;
+			constexpr static std::size_t BYTES_PER_PIXEL = 3;
 		};
 
 		struct RGBA
@@ -738,18 +3425,21 @@ namespace jikoLib
 			constexpr static GLenum TEXTURE_COLOR = GL_RGBA;
 			constexpr static std::size_t ALIGN = 4;
 			constexpr static ILenum IL_COLOR = IL_RGBA;
+			constexpr static std::size_t BYTES_PER_PIXEL = 4;
 		};
 
 		struct DepthComponent
 		{
 			constexpr static GLenum TEXTURE_COLOR = GL_DEPTH_COMPONENT;
 			constexpr static std::size_t ALIGN = 4;
+			constexpr static std::size_t BYTES_PER_PIXEL = 4;
 		};
 
 		struct DepthComponent16
 		{
 			constexpr static GLenum TEXTURE_COLOR = GL_DEPTH_COMPONENT16;
 			constexpr static std::size_t ALIGN = 4;
+			constexpr static std::size_t BYTES_PER_PIXEL = 2;
 		};
 
 		/**
@@ -783,8 +3473,10 @@ namespace jikoLib
 		template<typename TargetType, GLint level, typename int_format, typename format, typename TextureType>
 			struct TextureTraits
 			{
-				static void texImage2D(const std::string &path)
+				//returns bytes of the uploaded level (0 if failed)
+				static std::size_t texImage2D(const std::string &path)
 				{
+					std::size_t bytes = 0;
 					ILuint imgID;
 					ilGenImages(1, &imgID);
 					ilBindImage(imgID);
@@ -799,6 +3491,7 @@ namespace jikoLib
 							CHECK_GL_ERROR;
 							TexImage_D<2>::func(TargetType::TEXTURE_TARGET, level, int_format::TEXTURE_COLOR, (GLuint)ilGetInteger(IL_IMAGE_WIDTH),(GLuint)ilGetInteger(IL_IMAGE_HEIGHT), 0, format::TEXTURE_COLOR, GL_UNSIGNED_BYTE, static_cast<GLubyte*>(ilGetData()));
 							CHECK_GL_ERROR;
+							bytes += ilGetInteger(IL_IMAGE_WIDTH)*ilGetInteger(IL_IMAGE_HEIGHT)*int_format::BYTES_PER_PIXEL;
 						}
 					}
 					else
@@ -806,15 +3499,18 @@ namespace jikoLib
 						std::cerr << "cannot load image! --did nothing" << std::endl;
 					}
 					ilDeleteImages(1, &imgID);
+					MemoryStats::upload(bytes);
+					return bytes;
 				}
 
-				static void texImage2D(GLuint width, GLuint height)
+				static std::size_t texImage2D(GLuint width, GLuint height)
 				{
 					//null texture
 					glPixelStorei(GL_UNPACK_ALIGNMENT, format::ALIGN);
 					CHECK_GL_ERROR;
 					TexImage_D<2>::func(TargetType::TEXTURE_TARGET, level, int_format::TEXTURE_COLOR, width, height, 0, format::TEXTURE_COLOR, getEnum<TextureType>::value, static_cast<GLvoid*>(NULL));
 					CHECK_GL_ERROR;
+					return width*height*int_format::BYTES_PER_PIXEL;
 				}
 			};
 
@@ -822,7 +3518,7 @@ namespace jikoLib
 		template<GLint level, typename int_format,typename format, typename TextureType>
 			struct TextureTraits<TextureCubeMap, level, int_format, format, TextureType>
 			{
-				static void texImage2D(
+				static std::size_t texImage2D(
 						const std::string &neg_x,
 						const std::string &pos_x,
 						const std::string &neg_y,
@@ -834,6 +3530,7 @@ namespace jikoLib
 					ilGenImages(1, &imgID);
 					ilBindImage(imgID);
 					ILboolean success;
+					std::size_t bytes = 0;
 
 					//NEG_X
 					success = ilLoadImage(neg_x.c_str());
@@ -847,6 +3544,7 @@ namespace jikoLib
 							CHECK_GL_ERROR;
 							TexImage_D<2>::func(TextureCubeMap::TEXTURE_NEGX, level, int_format::TEXTURE_COLOR, (GLuint)ilGetInteger(IL_IMAGE_WIDTH),(GLuint)ilGetInteger(IL_IMAGE_HEIGHT), 0, format::TEXTURE_COLOR, GL_UNSIGNED_BYTE, static_cast<GLubyte*>(ilGetData()));
 							CHECK_GL_ERROR;
+							bytes += ilGetInteger(IL_IMAGE_WIDTH)*ilGetInteger(IL_IMAGE_HEIGHT)*int_format::BYTES_PER_PIXEL;
 						}
 					}
 					else
@@ -866,6 +3564,7 @@ namespace jikoLib
 							CHECK_GL_ERROR;
 							TexImage_D<2>::func(TextureCubeMap::TEXTURE_POSX, level, int_format::TEXTURE_COLOR, (GLuint)ilGetInteger(IL_IMAGE_WIDTH),(GLuint)ilGetInteger(IL_IMAGE_HEIGHT), 0, format::TEXTURE_COLOR, GL_UNSIGNED_BYTE, static_cast<GLubyte*>(ilGetData()));
 							CHECK_GL_ERROR;
+							bytes += ilGetInteger(IL_IMAGE_WIDTH)*ilGetInteger(IL_IMAGE_HEIGHT)*int_format::BYTES_PER_PIXEL;
 						}
 					}
 					else
@@ -885,6 +3584,7 @@ namespace jikoLib
 							CHECK_GL_ERROR;
 							TexImage_D<2>::func(TextureCubeMap::TEXTURE_NEGY, level, int_format::TEXTURE_COLOR, (GLuint)ilGetInteger(IL_IMAGE_WIDTH),(GLuint)ilGetInteger(IL_IMAGE_HEIGHT), 0, format::TEXTURE_COLOR, GL_UNSIGNED_BYTE, static_cast<GLubyte*>(ilGetData()));
 							CHECK_GL_ERROR;
+							bytes += ilGetInteger(IL_IMAGE_WIDTH)*ilGetInteger(IL_IMAGE_HEIGHT)*int_format::BYTES_PER_PIXEL;
 						}
 					}
 					else
@@ -904,6 +3604,7 @@ namespace jikoLib
 							CHECK_GL_ERROR;
 							TexImage_D<2>::func(TextureCubeMap::TEXTURE_POSY, level, int_format::TEXTURE_COLOR, (GLuint)ilGetInteger(IL_IMAGE_WIDTH),(GLuint)ilGetInteger(IL_IMAGE_HEIGHT), 0, format::TEXTURE_COLOR, GL_UNSIGNED_BYTE, static_cast<GLubyte*>(ilGetData()));
 							CHECK_GL_ERROR;
+							bytes += ilGetInteger(IL_IMAGE_WIDTH)*ilGetInteger(IL_IMAGE_HEIGHT)*int_format::BYTES_PER_PIXEL;
 						}
 					}
 					else
@@ -923,6 +3624,7 @@ namespace jikoLib
 							CHECK_GL_ERROR;
 							TexImage_D<2>::func(TextureCubeMap::TEXTURE_NEGZ, level, int_format::TEXTURE_COLOR, (GLuint)ilGetInteger(IL_IMAGE_WIDTH),(GLuint)ilGetInteger(IL_IMAGE_HEIGHT), 0, format::TEXTURE_COLOR, GL_UNSIGNED_BYTE, static_cast<GLubyte*>(ilGetData()));
 							CHECK_GL_ERROR;
+							bytes += ilGetInteger(IL_IMAGE_WIDTH)*ilGetInteger(IL_IMAGE_HEIGHT)*int_format::BYTES_PER_PIXEL;
 						}
 					}
 					else
@@ -942,6 +3644,7 @@ namespace jikoLib
 							CHECK_GL_ERROR;
 							TexImage_D<2>::func(TextureCubeMap::TEXTURE_POSZ, level, int_format::TEXTURE_COLOR, (GLuint)ilGetInteger(IL_IMAGE_WIDTH),(GLuint)ilGetInteger(IL_IMAGE_HEIGHT), 0, format::TEXTURE_COLOR, GL_UNSIGNED_BYTE, static_cast<GLubyte*>(ilGetData()));
 							CHECK_GL_ERROR;
+							bytes += ilGetInteger(IL_IMAGE_WIDTH)*ilGetInteger(IL_IMAGE_HEIGHT)*int_format::BYTES_PER_PIXEL;
 						}
 					}
 					else
@@ -951,6 +3654,8 @@ namespace jikoLib
 
 
 					ilDeleteImages(1, &imgID);
+					MemoryStats::upload(bytes);
+					return bytes;
 				}
 
 			};
@@ -960,16 +3665,24 @@ namespace jikoLib
 		 *
 		 */
 
+		inline void texParameteri(GLenum target, GLuint texture, GLenum pname, GLint param)
+		{
+			if(USE_DSA)
+				glTextureParameteri(texture, pname, param);
+			else
+				glTexParameteri(target, pname, param);
+			CHECK_GL_ERROR;
+		}
+
 		template<GLenum param>
 			struct Wrap_S{
 				static_assert((param == GL_CLAMP_TO_EDGE)||
 								  (param == GL_REPEAT)||
 								  (param == GL_CLAMP_TO_BORDER)||
 								  (param == GL_CLAMP), "invalid param");
-				static void setTextureParameter(GLenum target)
+				static void setTextureParameter(GLenum target, GLuint texture)
 				{
-					glTexParameteri(target, GL_TEXTURE_WRAP_S, param);
-					CHECK_GL_ERROR;
+					texParameteri(target, texture, GL_TEXTURE_WRAP_S, param);
 				}
 			};
 		template<GLenum param>
@@ -978,10 +3691,9 @@ namespace jikoLib
 								  (param == GL_REPEAT)||
 								  (param == GL_CLAMP_TO_BORDER)||
 								  (param == GL_CLAMP), "invalid param");
-				static void setTextureParameter(GLenum target)
+				static void setTextureParameter(GLenum target, GLuint texture)
 				{
-					glTexParameteri(target, GL_TEXTURE_WRAP_T, param);
-					CHECK_GL_ERROR;
+					texParameteri(target, texture, GL_TEXTURE_WRAP_T, param);
 				}
 			};
 		template<GLenum param>
@@ -990,30 +3702,27 @@ namespace jikoLib
 								  (param == GL_REPEAT)||
 								  (param == GL_CLAMP_TO_BORDER)||
 								  (param == GL_CLAMP), "invalid param");
-				static void setTextureParameter(GLenum target)
+				static void setTextureParameter(GLenum target, GLuint texture)
 				{
-					glTexParameteri(target, GL_TEXTURE_WRAP_R, param);
-					CHECK_GL_ERROR;
+					texParameteri(target, texture, GL_TEXTURE_WRAP_R, param);
 				}
 			};
 		template<GLenum param>
 			struct Mag_Filter{
 				static_assert((param == GL_NEAREST)||
 								  (param == GL_LINEAR), "invalid param");
-				static void setTextureParameter(GLenum target)
+				static void setTextureParameter(GLenum target, GLuint texture)
 				{
-					glTexParameteri(target, GL_TEXTURE_MAG_FILTER, param);
-					CHECK_GL_ERROR;
+					texParameteri(target, texture, GL_TEXTURE_MAG_FILTER, param);
 				}
 			};
 		template<GLenum param>
 			struct Min_Filter{
 				static_assert((param == GL_NEAREST)||
 								  (param == GL_LINEAR), "invalid param");
-				static void setTextureParameter(GLenum target)
+				static void setTextureParameter(GLenum target, GLuint texture)
 				{
-					glTexParameteri(target, GL_TEXTURE_MIN_FILTER, param);
-					CHECK_GL_ERROR;
+					texParameteri(target, texture, GL_TEXTURE_MIN_FILTER, param);
 				}
 			};
 		template<GLenum param>
@@ -1026,30 +3735,27 @@ namespace jikoLib
 								  (param == GL_NOTEQUAL)||
 								  (param == GL_ALWAYS)||
 								  (param == GL_NEVER), "invalid param");
-				static void setTextureParameter(GLenum target)
+				static void setTextureParameter(GLenum target, GLuint texture)
 				{
-					glTexParameteri(target, GL_TEXTURE_COMPARE_FUNC, param);
-					CHECK_GL_ERROR;
+					texParameteri(target, texture, GL_TEXTURE_COMPARE_FUNC, param);
 				}
 			};
 		template<GLenum param>
 			struct CompareMode{
 				static_assert((param == GL_COMPARE_REF_TO_TEXTURE)||
 								  (param == GL_NONE), "invalid param");
-				static void setTextureParameter(GLenum target)
+				static void setTextureParameter(GLenum target, GLuint texture)
 				{
-					glTexParameteri(target, GL_TEXTURE_COMPARE_MODE, param);
-					CHECK_GL_ERROR;
+					texParameteri(target, texture, GL_TEXTURE_COMPARE_MODE, param);
 				}
 			};
 		template<GLenum param>
 			struct GenerateMipmap{
 				static_assert((param == GL_TRUE)||
 								  (param == GL_FALSE), "invalid param");
-				static void setTextureParameter(GLenum target)
+				static void setTextureParameter(GLenum target, GLuint texture)
 				{
-					glTexParameteri(target, GL_GENERATE_MIPMAP, param);
-					CHECK_GL_ERROR;
+					texParameteri(target, texture, GL_GENERATE_MIPMAP, param);
 				}
 			};
 
@@ -1062,19 +3768,19 @@ namespace jikoLib
 		template<typename First, typename... Args>
 			struct SetParamTraits
 			{
-				inline static void func(GLenum target)
+				inline static void func(GLenum target, GLuint texture)
 				{
-					First::setTextureParameter(target);
-					SetParamTraits<Args...>::func(target);
+					First::setTextureParameter(target, texture);
+					SetParamTraits<Args...>::func(target, texture);
 				}
 			};
 
 		template<typename Last>
 			struct SetParamTraits<Last>
 			{
-				inline static void func(GLenum target)
+				inline static void func(GLenum target, GLuint texture)
 				{
-					Last::setTextureParameter(target);
+					Last::setTextureParameter(target, texture);
 				}
 			};
 
@@ -135,32 +135,105 @@ namespace jikoLib{
 							std::cerr << "Array is not set! --did nothing" << std::endl;
 							return;
 						}
-						if(getSizeof(buffer.getArrayEnum()) == 0)
+						connectAttrib(prog.getAttribLocation(name), varray.getID(), buffer.getID(), buffer.getDim(), buffer.getArrayEnum(), buffer.getNormalized());
+					}
+
+				//attribute setup on plain GL names (shared by wrappers and ResourceStore handles)
+				void connectAttrib(GLint attribloc, GLuint varray, GLuint buffer, std::size_t dim, GLenum type, GLboolean normalized = GL_FALSE)
+				{
+					if(getAttribSize(type, dim) == 0)
+					{
+						std::cerr << "buffer ArrayEnum is invalid! --did nothing" << std::endl;
+						return;
+					}
+					if(attribloc == -1)
+						return;
+					if(USE_DSA)
+					{
+						//binding index = attribute location
+						glVertexArrayVertexBuffer(varray, attribloc, buffer, 0, getAttribSize(type, dim));
+						glVertexArrayAttribFormat(varray, attribloc, dim, type, normalized, 0);
+						glVertexArrayAttribBinding(varray, attribloc, attribloc);
+						glEnableVertexArrayAttrib(varray, attribloc);
+						CHECK_GL_ERROR;
+						return;
+					}
+					BindState::bindVertexArray(varray);
+					BindState::bindBuffer(GL_ARRAY_BUFFER, buffer);
+					glVertexAttribPointer(attribloc, dim, type, normalized, getAttribSize(type, dim), 0);
+					CHECK_GL_ERROR;
+					glEnableVertexAttribArray(attribloc);
+					CHECK_GL_ERROR;
+					if(BindState::isLazyUnbind())
+						return;
+					BindState::bindBuffer(GL_ARRAY_BUFFER, 0);
+					BindState::bindVertexArray(0);
+				}
+
+				//interleaved buffer. names are given in Format order, "" (or a missing trailing name) skips the attribute.
+				//all attributes share one buffer binding, so the whole layout is set up with one bind.
+				template<typename Format, typename UsageType, typename Allocator_sh, typename Allocator_vb, typename Allocator_va, typename... Names>
+					void connectAttrib(const ShaderProg<Allocator_sh> &prog, const InterleavedBuffer<Format, UsageType, Allocator_vb> &buffer, const VertexArray<Allocator_va> &varray, const Names&... names)
+					{
+						static_assert(sizeof...(Names) <= Format::NUM_ATTRIB, "too many attribute names");
+						if(!buffer.getisSetArray())
 						{
-							std::cerr << "buffer ArrayEnum is invalid! --did nothing" << std::endl;
+							std::cerr << "Array is not set! --did nothing" << std::endl;
 							return;
 						}
-						varray.bind();
-						buffer.bind();
-						GLint attribloc = glGetAttribLocation(prog.getID(), name.c_str());
-						CHECK_GL_ERROR;
-						if(attribloc == -1)
+						const std::string name_array[] = {names..., ""};
+						const GLuint varray_id = varray.getID();
+						if(USE_DSA)
 						{
-							std::cerr << "attribute variable " << name << " cannot be found" << std::endl;
-							return;
+							//binding index 0 of the vertex array is the interleaved buffer
+							glVertexArrayVertexBuffer(varray_id, 0, buffer.getID(), 0, Format::stride());
+							CHECK_GL_ERROR;
 						}
-						glVertexAttribPointer(attribloc, buffer.getDim(), buffer.getArrayEnum(), GL_FALSE, buffer.getDim()*getSizeof(buffer.getArrayEnum()), 0);
-						CHECK_GL_ERROR;
-						glEnableVertexAttribArray(attribloc);
-						CHECK_GL_ERROR;
-						buffer.unbind();
-						varray.unbind();
+						else
+						{
+							BindState::bindVertexArray(varray_id);
+							BindState::bindBuffer(GL_ARRAY_BUFFER, buffer.getID());
+						}
+						for(std::size_t i=0; i<sizeof...(Names); i++)
+						{
+							if(name_array[i] == "")
+								continue;
+							GLint attribloc = prog.getAttribLocation(name_array[i]);
+							if(attribloc == -1)
+								continue;
+							if(USE_DSA)
+							{
+								glVertexArrayAttribFormat(varray_id, attribloc, Format::dim(i), Format::type(i), Format::normalized(i), Format::offset(i));
+								glVertexArrayAttribBinding(varray_id, attribloc, 0);
+								glEnableVertexArrayAttrib(varray_id, attribloc);
+								CHECK_GL_ERROR;
+								continue;
+							}
+							glVertexAttribPointer(attribloc, Format::dim(i), Format::type(i), Format::normalized(i), Format::stride(), reinterpret_cast<const GLvoid*>(Format::offset(i)));
+							CHECK_GL_ERROR;
+							glEnableVertexAttribArray(attribloc);
+							CHECK_GL_ERROR;
+						}
+						if(USE_DSA || BindState::isLazyUnbind())
+							return;
+						BindState::bindBuffer(GL_ARRAY_BUFFER, 0);
+						BindState::bindVertexArray(0);
+					}
+
+				//every slice of the arena uses these attributes
+				template<typename Format, typename IndexType, typename UsageType, typename Allocator_sh, typename... Names>
+					inline void connectAttrib(const ShaderProg<Allocator_sh> &prog, const GeometryArena<Format, IndexType, UsageType> &arena, const Names&... names)
+					{
+						this->connectAttrib(prog, arena.getVertex(), arena.getVArray(), names...);
 					}
 
 				template<typename Allocator_sh>
 					void disconnectAttrib(const ShaderProg<Allocator_sh> &prog, const std::string &name)
 					{
-						glDisableVertexAttribArray(glGetAttribLocation(prog.getID(), name.c_str()));
+						GLint attribloc = prog.getAttribLocation(name);
+						if(attribloc == -1)
+							return;
+						glDisableVertexAttribArray(attribloc);
 						CHECK_GL_ERROR;
 					}
 
@@ -174,6 +247,54 @@ namespace jikoLib{
 							this->connectAttrib(prog, mesh.getTexcrd(), mesh.getVArray(), texcrd_attr);
 					}
 
+				template<typename Format, typename Allocator_sh, typename... Names>
+					inline void connectAttrib(const ShaderProg<Allocator_sh> &prog, const InterleavedMesh3D<Format> &mesh, const Names&... names)
+					{
+						this->connectAttrib(prog, mesh.getVertex(), mesh.getVArray(), names...);
+					}
+
+				//ResourceStore mesh
+				void connectAttrib(const ResourceStore &store, ResourceStore::ProgramHandle prog, ResourceStore::MeshHandle mesh, const std::string &vertex_attr, const std::string &normal_attr = "", const std::string &texcrd_attr = "")
+				{
+					const ResourceStore::ProgramRecord *p = store.get(prog);
+					const ResourceStore::MeshRecord *m = store.get(mesh);
+					const ResourceStore::VertexArrayRecord *va = (m != nullptr) ? store.get(m->varray) : nullptr;
+					if((p == nullptr)||(va == nullptr))
+					{
+						std::cerr << "stale handle! --did nothing" << std::endl;
+						return;
+					}
+					const std::string names[] = {vertex_attr, normal_attr, texcrd_attr};
+					const ResourceStore::BufferHandle buffers[] = {m->vertex, m->normal, m->texcrd};
+					for(std::size_t i=0; i<3; i++)
+					{
+						const ResourceStore::BufferRecord *b = store.get(buffers[i]);
+						if((names[i] == "")||(b == nullptr))
+							continue;
+						connectAttrib(p->program->getAttribLocation(names[i]), va->id, b->id, b->dim, b->type);
+					}
+				}
+
+				template<typename UsageType, typename Allocator_sh, typename Allocator_ub>
+					void connectUniformBlock(ShaderProg<Allocator_sh> &prog, const VertexBuffer<UniformBuffer, UsageType, Allocator_ub> &buffer, const std::string &name, GLuint binding)
+					{
+						if(!buffer.getisSetArray())
+						{
+							std::cerr << "Block is not set! --did nothing" << std::endl;
+							return;
+						}
+						GLint block_size = prog.getUniformBlockSize(name);
+						if(block_size == 0)
+							return;
+						if(static_cast<std::size_t>(block_size) > buffer.getSizeElem()*buffer.getDim()*getSizeof(buffer.getArrayEnum()))
+						{
+							std::cerr << "uniform block " << name << " needs " << block_size << " B. buffer is too small --did nothing" << std::endl;
+							return;
+						}
+						prog.setUniformBlockBinding(name, binding);
+						buffer.bindBase(binding);
+					}
+
 				inline void viewport(GLint x, GLint y, GLsizei width, GLsizei height)
 				{
 					glViewport(x,y,width,height);
@@ -342,6 +463,85 @@ namespace jikoLib{
 							draw<RenderMode>(obj.getVArray(), program, obj.getVertex());
 					}
 
+				template<typename RenderMode = rm_Triangles, typename Format, typename Sp_Alloc>
+					inline void draw(const InterleavedMesh3D<Format> &obj, const ShaderProg<Sp_Alloc> &program)
+					{
+						if(obj.getIsIndexSet())
+							draw<RenderMode>(obj.getVArray(), program, obj.getIndex());
+						else
+							draw<RenderMode>(obj.getVArray(), program, obj.getVertex().getBuffer());
+					}
+
+
+				//arena slice. the vertex array and index buffer are shared, so consecutive slices
+				//of one arena only change the offsets (bindings are cached by BindState)
+				template<typename RenderMode = rm_Triangles, typename Format, typename IndexType, typename UsageType, typename Sp_Alloc>
+					void draw(const GeometryArena<Format, IndexType, UsageType> &arena, const GeometrySlice &slice, const ShaderProg<Sp_Alloc> &program)
+					{
+						if(slice.isNull())
+						{
+							std::cerr << "slice is null. cannot draw" << std::endl;
+							return;
+						}
+						arena.getVArray().bind();
+						program.bind();
+						if(slice.isIndexed())
+						{
+							arena.getIndex().bind();
+							glDrawElementsBaseVertex(RenderMode::RENDER_MODE, slice.num_index, getEnum<IndexType>::value,
+									reinterpret_cast<const GLvoid*>(slice.first_index*sizeof(IndexType)), slice.base_vertex);
+						}
+						else
+						{
+							glDrawArrays(RenderMode::RENDER_MODE, slice.base_vertex, slice.num_vertex);
+						}
+						CHECK_GL_ERROR;
+						program.unbind();
+						if(slice.isIndexed())
+							arena.getIndex().unbind();
+						arena.getVArray().unbind();
+					}
+
+				template<typename RenderMode = rm_Triangles, typename Format, typename IndexType, typename UsageType, typename Sp_Alloc>
+					inline void draw(const GeometryArena<Format, IndexType, UsageType> &arena, const ArenaMesh3D &mesh, const ShaderProg<Sp_Alloc> &program)
+					{
+						draw<RenderMode>(arena, mesh.getSlice(), program);
+					}
+
+
+				//ResourceStore mesh. a stale handle draws nothing
+				template<typename RenderMode = rm_Triangles>
+					void draw(const ResourceStore &store, ResourceStore::MeshHandle mesh, ResourceStore::ProgramHandle prog)
+					{
+						const ResourceStore::MeshRecord *m = store.get(mesh);
+						const ResourceStore::ProgramRecord *p = store.get(prog);
+						const ResourceStore::VertexArrayRecord *va = (m != nullptr) ? store.get(m->varray) : nullptr;
+						if((p == nullptr)||(va == nullptr))
+						{
+							std::cerr << "stale handle. cannot draw" << std::endl;
+							return;
+						}
+						BindState::bindVertexArray(va->id);
+						p->program->bind();
+						const ResourceStore::BufferRecord *ibo = store.get(m->index);
+						const ResourceStore::BufferRecord *vbo = store.get(m->vertex);
+						if(ibo != nullptr)
+						{
+							BindState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo->id);
+							glDrawElements(RenderMode::RENDER_MODE, ibo->size_elem, ibo->type, NULL);
+						}
+						else if(vbo != nullptr)
+						{
+							glDrawArrays(RenderMode::RENDER_MODE, 0, vbo->size_elem);
+						}
+						CHECK_GL_ERROR;
+						p->program->unbind();
+						if(BindState::isLazyUnbind())
+							return;
+						if(ibo != nullptr)
+							BindState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+						BindState::bindVertexArray(0);
+					}
 
 				template<typename RenderMode = rm_Triangles, typename Sp_Alloc, typename TexTarget, typename TexAlloc>
 					inline void draw(const Mesh3D &obj, const ShaderProg<Sp_Alloc> &program, const std::vector<std::tuple<Texture<TexTarget, TexAlloc>, std::size_t>> &tex_array)
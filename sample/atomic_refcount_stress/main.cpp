@@ -0,0 +1,126 @@
+#include "../include/gllib/gl_all.h"
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_opengl.h>
+
+//note: needs -pthread (add it to LIBPATH in Makefile).
+//      build without -DDEBUG, or every copy prints a line.
+
+jikoLib::GLLib::GLObject obj;
+
+using AtomicVBO = jikoLib::GLLib::VertexBuffer<jikoLib::GLLib::ArrayBuffer, jikoLib::GLLib::StaticDraw, jikoLib::GLLib::GLAtomicAllocator<jikoLib::GLLib::Alloc_VertexBuffer>>;
+using AtomicTexture = jikoLib::GLLib::Texture<jikoLib::GLLib::Texture2D, jikoLib::GLLib::GLAtomicAllocator<jikoLib::GLLib::Alloc_Texture>>;
+
+const std::size_t NUM_OBJECT = 256;
+const std::size_t NUM_THREAD = 8;
+const int NUM_ROUND = 2000;
+const std::size_t NUM_COPY = 64;
+
+//copy random handles, shuffle and drop them, again and again.
+//the thread owns its own copy of every handle and drops it last, so the final release happens here
+void worker(std::vector<AtomicVBO> vbos, std::vector<AtomicTexture> textures, unsigned int seed, std::atomic<std::size_t> &num_done)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<std::size_t> pick(0, NUM_OBJECT-1);
+	for(int round=0; round<NUM_ROUND; round++)
+	{
+		std::vector<AtomicVBO> vbo_copies;
+		std::vector<AtomicTexture> texture_copies;
+		for(std::size_t i=0; i<NUM_COPY; i++)
+		{
+			vbo_copies.push_back(vbos[pick(rng)]);
+			texture_copies.push_back(textures[pick(rng)]);
+		}
+		std::shuffle(vbo_copies.begin(), vbo_copies.end(), rng);
+		//copy assignment drops the old reference and takes the new one
+		for(std::size_t i=1; i<texture_copies.size(); i++)
+			texture_copies[i-1] = texture_copies[i];
+	}
+	//shuffle the order of the final drops too
+	std::shuffle(vbos.begin(), vbos.end(), rng);
+	vbos.clear();
+	textures.clear();
+	num_done++;
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace jikoLib::GLLib;
+
+	if(SDL_Init(SDL_INIT_EVERYTHING) < 0)
+	{
+		std::cerr << "Cannot Initialize SDL!: " << SDL_GetError() << std::endl;
+		return -1;
+	}
+
+	SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 16);
+	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+
+	SDL_Window* window = SDL_CreateWindow("SDL_Window", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 400, 300, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+	if(window == NULL)
+	{
+		std::cerr << "Window could not be created!: " << SDL_GetError() << std::endl;
+	}
+
+	SDL_GLContext context;
+
+	context = SDL_GL_CreateContext(window);
+
+	obj << Begin();
+
+	SDL_GL_MakeCurrent(window, context);
+
+	//objects are created on the GL thread
+	std::vector<AtomicVBO> vbos(NUM_OBJECT);
+	std::vector<AtomicTexture> textures(NUM_OBJECT);
+	const GLfloat data[] = {0.0f, 1.0f, 2.0f};
+	for(auto&& vbo : vbos)
+		vbo.copyData(data, 1, 3);
+
+	const std::size_t deleted_before = RetireQueue::getNumDeleted();
+	auto start = std::chrono::steady_clock::now();
+
+	std::atomic<std::size_t> num_done(0);
+	std::vector<std::thread> threads;
+	for(std::size_t i=0; i<NUM_THREAD; i++)
+		threads.emplace_back(worker, vbos, textures, static_cast<unsigned int>(i+1), std::ref(num_done));
+	//the GL thread lets go first. the last reference of every object dies on some worker
+	vbos.clear();
+	textures.clear();
+
+	//keep retiring frames while the workers run
+	while(num_done < NUM_THREAD)
+	{
+		RetireQueue::endFrame();
+		SDL_Delay(1);
+	}
+	for(auto&& t : threads)
+		t.join();
+	RetireQueue::finish();
+
+	auto end = std::chrono::steady_clock::now();
+
+	const std::size_t num_deleted = RetireQueue::getNumDeleted() - deleted_before;
+	const std::size_t num_copy = NUM_THREAD*NUM_ROUND*NUM_COPY*2;
+	std::cout << NUM_THREAD << " threads, " << num_copy << " handle copies in "
+		<< std::chrono::duration<double, std::milli>(end - start).count() << " msec" << std::endl;
+	std::cout << "names deleted: " << num_deleted << " (expected " << 2*NUM_OBJECT << ")" << std::endl;
+	std::cout << "names pending: " << RetireQueue::getNumPending() << " (expected 0)" << std::endl;
+
+	const bool ok = (num_deleted == 2*NUM_OBJECT)&&(RetireQueue::getNumPending() == 0);
+	std::cout << (ok ? "OK" : "FAILED") << std::endl;
+
+	SDL_GL_DeleteContext(context);
+	SDL_DestroyWindow(window);
+	SDL_Quit();
+
+	return ok ? 0 : 1;
+}
@@ -74,6 +74,7 @@ int main(int argc, char* argv[])
 	Mesh3D mesh_sp;
 	MeshSample::Sphere sphere(30.0f, 50, 50);
 	mesh_sp.copyData(sphere.getVertex(), sphere.getNormal(), sphere.getTexcrd(), sphere.getNumVertex());
+	mesh_sp.copyIndexNarrowed(sphere.getIndex(), sphere.getNumIndex());
 	mesh_sp.setPos(glm::vec3(0.0f, 0.0f, -200.0f));
 
 	Camera camera;
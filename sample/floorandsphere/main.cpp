@@ -112,6 +112,7 @@ int main(int argc, char* argv[])
 	Mesh3D cube_mesh;
 	MeshSample::Sphere cubehelper(5.0, 50, 50);
 	cube_mesh.copyData(cubehelper.getVertex(), cubehelper.getNormal(), cubehelper.getTexcrd(), cubehelper.getNumVertex());
+	cube_mesh.copyIndexNarrowed(cubehelper.getIndex(), cubehelper.getNumIndex());
 	cube_mesh.setPos(glm::vec3(0.0f, 0.0f, 5.0f));
 
 	Camera camera;
@@ -0,0 +1,111 @@
+#include "../include/gllib/gl_all.h"
+#include <vector>
+#include <chrono>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_opengl.h>
+
+jikoLib::GLLib::GLObject obj;
+
+const std::string vshader_source = 
+#include "shader.vert"
+;
+const std::string fshader_source = 
+#include "shader.frag"
+;
+
+//number of distinct programs (variants) to build per pass
+const int NUM_VARIANT = 32;
+
+//insert "#define VARIANT n" after #version line so that the driver cannot reuse a previous result
+std::string makeVariant(const std::string &source, int n)
+{
+	std::string result = source;
+	std::size_t pos = result.find("#version");
+	pos = (pos == std::string::npos) ? 0 : result.find('\n', pos) + 1;
+	result.insert(pos, "#define VARIANT " + std::to_string(n) + "\n");
+	return result;
+}
+
+//submit all variants, then poll isReady() like a render loop would. returns elapsed time in msec
+double buildAll(int offset)
+{
+	using namespace jikoLib::GLLib;
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<ShaderProgram> programs(NUM_VARIANT);
+	for(int i=0; i<NUM_VARIANT; i++)
+	{
+		VShader vshader;
+		FShader fshader;
+		vshader << makeVariant(vshader_source, offset+i);
+		fshader << makeVariant(fshader_source, offset+i);
+		programs[i] << vshader << fshader << link_these();
+	}
+	auto submitted = std::chrono::steady_clock::now();
+
+	int num_polls = 0;
+	bool all_ready = false;
+	while(!all_ready)
+	{
+		//a real application would draw a frame here
+		all_ready = true;
+		for(auto&& program : programs)
+			all_ready = program.isReady() && all_ready;
+		num_polls++;
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	std::cout << "  submit: " << std::chrono::duration<double, std::milli>(submitted - start).count() << " msec, "
+		<< "polls: " << num_polls << std::endl;
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace jikoLib::GLLib;
+
+	if(SDL_Init(SDL_INIT_EVERYTHING) < 0)
+	{
+		std::cerr << "Cannot Initialize SDL!: " << SDL_GetError() << std::endl;
+		return -1;
+	}
+
+	SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 16);
+	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1); 
+
+	SDL_Window* window = SDL_CreateWindow("SDL_Window", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 400, 300, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+	if(window == NULL)
+	{
+		std::cerr << "Window could not be created!: " << SDL_GetError() << std::endl;
+	}
+
+	SDL_GLContext context;
+
+	context = SDL_GL_CreateContext(window);
+
+	obj << Begin();
+
+	SDL_GL_MakeCurrent(window, context);
+
+	std::cout << "KHR_parallel_shader_compile: " << (ParallelShaderCompile::isSupported() ? "yes" : "no") << std::endl;
+
+	std::cout << "serial" << std::endl;
+	const double t_serial = buildAll(0);
+
+	ParallelShaderCompile::setEnabled(true);
+	std::cout << "parallel" << std::endl;
+	const double t_parallel = buildAll(NUM_VARIANT);
+
+	std::cout << NUM_VARIANT << " programs" << std::endl;
+	std::cout << "serial  : " << t_serial << " msec" << std::endl;
+	std::cout << "parallel: " << t_parallel << " msec" << std::endl;
+
+	SDL_GL_DeleteContext(context);
+	SDL_DestroyWindow(window);
+	SDL_Quit();
+
+	return 0;
+}
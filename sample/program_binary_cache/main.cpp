@@ -0,0 +1,122 @@
+#include "../include/gllib/gl_all.h"
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_opengl.h>
+
+jikoLib::GLLib::GLObject obj;
+
+const std::string vshader_source = 
+#include "shader.vert"
+;
+const std::string fshader_source = 
+#include "shader.frag"
+;
+
+//number of distinct programs (variants) to build per pass
+const int NUM_VARIANT = 32;
+
+//insert "#define VARIANT n" after #version line so that every program has its own cache entry
+std::string makeVariant(const std::string &source, int n)
+{
+	std::string result = source;
+	std::size_t pos = result.find("#version");
+	pos = (pos == std::string::npos) ? 0 : result.find('\n', pos) + 1;
+	result.insert(pos, "#define VARIANT " + std::to_string(n) + "\n");
+	return result;
+}
+
+//compile and link all variants. returns elapsed time in msec
+//clear: remove the cache entries of these programs before linking
+double buildAll(bool clear = false)
+{
+	using namespace jikoLib::GLLib;
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<ShaderProgram> programs(NUM_VARIANT);
+	for(int i=0; i<NUM_VARIANT; i++)
+	{
+		VShader vshader;
+		FShader fshader;
+		vshader << makeVariant(vshader_source, i);
+		fshader << makeVariant(fshader_source, i);
+		programs[i] << vshader << fshader;
+		if(clear)
+			std::remove(ProgramBinaryCache::getPath(programs[i].getSourceHash()).c_str());
+		programs[i] << link_these();
+	}
+	//wait for driver
+	glFinish();
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace jikoLib::GLLib;
+
+	//usage: ./a.out [cache directory (must exist)]
+	const std::string cache_dir = (argc > 1) ? argv[1] : ".";
+
+	if(SDL_Init(SDL_INIT_EVERYTHING) < 0)
+	{
+		std::cerr << "Cannot Initialize SDL!: " << SDL_GetError() << std::endl;
+		return -1;
+	}
+
+	SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 16);
+	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1); 
+
+	SDL_Window* window = SDL_CreateWindow("SDL_Window", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 400, 300, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+	if(window == NULL)
+	{
+		std::cerr << "Window could not be created!: " << SDL_GetError() << std::endl;
+	}
+
+	SDL_GLContext context;
+
+	context = SDL_GL_CreateContext(window);
+
+	obj << Begin();
+
+	SDL_GL_MakeCurrent(window, context);
+
+	GLint num_formats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+	std::cout << "program binary formats: " << num_formats << std::endl;
+
+	if(num_formats == 0)
+	{
+		std::cerr << "driver has no program binary format. cache cannot be used" << std::endl;
+		SDL_GL_DeleteContext(context);
+		SDL_DestroyWindow(window);
+		SDL_Quit();
+		return -1;
+	}
+
+	//cold: our cache entries are removed first, so every program is compiled and saved.
+	//      this runs first so that nothing is compiled in this process yet.
+	//      the driver's own disk cache (if any) is not cleared and may still hit.
+	ProgramBinaryCache::setDirectory(cache_dir);
+	const double t_cold = buildAll(true);
+	//warm: every program is loaded from the entries written above
+	const double t_warm = buildAll();
+	//our cache disabled: compile from source again. the driver has seen these sources by now
+	ProgramBinaryCache::setDirectory("");
+	const double t_source = buildAll();
+
+	std::cout << NUM_VARIANT << " programs" << std::endl;
+	std::cout << "cold cache (compile + save)      : " << t_cold << " msec" << std::endl;
+	std::cout << "warm cache (load binary)         : " << t_warm << " msec" << std::endl;
+	std::cout << "no cache (compile, driver warmed): " << t_source << " msec" << std::endl;
+
+	SDL_GL_DeleteContext(context);
+	SDL_DestroyWindow(window);
+	SDL_Quit();
+
+	return 0;
+}
@@ -123,6 +123,7 @@ int main(int argc, char* argv[])
 	Mesh3D sphere_mesh;
 	MeshSample::Sphere spherehelper(5.0, 50, 50);
 	sphere_mesh.copyData(spherehelper.getVertex(), spherehelper.getNormal(), spherehelper.getTexcrd(), spherehelper.getNumVertex());
+	sphere_mesh.copyIndexNarrowed(spherehelper.getIndex(), spherehelper.getNumIndex());
 	sphere_mesh.setPos(glm::vec3(0.0f, 0.0f, 5.0f));
 
 	Camera camera;
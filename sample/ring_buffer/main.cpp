@@ -0,0 +1,145 @@
+#include "../include/gllib/gl_all.h"
+#include <vector>
+#include <chrono>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_opengl.h>
+
+jikoLib::GLLib::GLObject obj;
+
+const std::string vshader_source = 
+#include "shader.vert"
+;
+const std::string fshader_source = 
+#include "shader.frag"
+;
+
+//GRID x GRID cubes, one model matrix each per frame
+const int GRID = 40;
+
+int width = 800;
+int height = 600;
+
+int main(int argc, char* argv[])
+{
+	using namespace jikoLib::GLLib;
+
+	if(SDL_Init(SDL_INIT_EVERYTHING) < 0)
+	{
+		std::cerr << "Cannot Initialize SDL!: " << SDL_GetError() << std::endl;
+		return -1;
+	}
+
+	SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 16);
+	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1); 
+
+	SDL_Window* window = SDL_CreateWindow("SDL_Window", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, width, height, SDL_WINDOW_OPENGL);
+	if(window == NULL)
+	{
+		std::cerr << "Window could not be created!: " << SDL_GetError() << std::endl;
+	}
+
+	SDL_GLContext context;
+
+	context = SDL_GL_CreateContext(window);
+
+	obj << Begin();
+
+	SDL_GL_SetSwapInterval(1);
+
+	SDL_GL_MakeCurrent(window, context);
+
+	if(!RingBuffer<>::isSupported())
+	{
+		std::cerr << "ARB_buffer_storage is not supported!" << std::endl;
+		return -1;
+	}
+
+	ShaderProgram program;
+	VShader vshader;
+	FShader fshader;
+	vshader << vshader_source;
+	fshader << fshader_source;
+	program << vshader << fshader << link_these();
+	program.setUniformBlockBinding("ModelBlock", 0);
+
+	Mesh3D cube;
+	MeshSample::Cube cubeHelper(1.0);
+	cube.copyData(cubeHelper.getVertex(), cubeHelper.getNormal(), cubeHelper.getNumVertex());
+	obj.connectAttrib(program, cube, "vertex", "normal");
+
+	//one region per frame in flight. 256 B covers the worst GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+	RingBuffer<> ring(GRID*GRID*256);
+
+	Camera camera;
+	camera.setPos(glm::vec3(0.0f, 40.0f, -60.0f));
+	camera.setDrct(glm::vec3(0.0f, 0.0f, 0.0f));
+	camera.setAspect(width, height);
+	camera.setFar(500.0f);
+
+	auto view_handle = program.getUniformHandle("view");
+	auto projection_handle = program.getUniformHandle("projection");
+
+	unsigned int frame_count = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	bool quit = false;
+	SDL_Event e;
+
+	while( !quit )
+	{
+		while( SDL_PollEvent( &e ) != 0 )
+		{
+			if( e.type == SDL_QUIT )
+			{
+				quit = true;
+			}
+		}
+
+		obj.clearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		obj.clearDepth(1.0);
+		obj.viewport(0,0,width,height);
+		obj.clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		glEnable(GL_DEPTH_TEST);
+
+		program.setUniformMatrixXtv(view_handle, glm::value_ptr(camera.getViewMatrix()), 1, 4);
+		program.setUniformMatrixXtv(projection_handle, glm::value_ptr(camera.getProjectionMatrix()), 1, 4);
+
+		//waits only if the GPU is more than two frames behind
+		ring.beginFrame();
+
+		const float angle = 0.01f*frame_count;
+		for(int z=0; z<GRID; z++)
+		{
+			for(int x=0; x<GRID; x++)
+			{
+				cube.setPos(glm::vec3(2.0f*(x-GRID/2), 0.0f, 2.0f*(z-GRID/2)));
+				cube.resetRot();
+				cube.rotate(glm::vec3(0.0f, 1.0f, 0.0f), angle+0.1f*(x+z));
+
+				//instead of program.setUniformMatrixXtv("model", ...) per mesh
+				auto model = ring.push(glm::value_ptr(cube.getModelMatrix()), 16);
+				ring.bindRange(0, model);
+				obj.draw(cube, program);
+			}
+		}
+
+		ring.endFrame();
+
+		SDL_GL_SwapWindow( window );
+
+		if(++frame_count % 300 == 0)
+		{
+			auto now = std::chrono::steady_clock::now();
+			std::cout << "frame time: " << std::chrono::duration<double, std::milli>(now - start).count()/300 << " msec" << std::endl;
+			start = now;
+		}
+	}
+
+	SDL_GL_DeleteContext(context);
+	SDL_DestroyWindow(window);
+	SDL_Quit();
+	return 0;
+}
@@ -0,0 +1,13 @@
+R"(
+#version 330
+
+in vec3 Normal;
+
+out vec4 FragColor;
+
+void main()
+{
+	float diffuse = max(dot(normalize(Normal), normalize(vec3(0.3, 1.0, 0.5))), 0.0);
+	FragColor = vec4(vec3(0.2 + 0.8*diffuse), 1.0);
+}
+)"
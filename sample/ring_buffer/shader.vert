@@ -0,0 +1,23 @@
+R"(
+#version 330
+
+in vec3 vertex;
+in vec3 normal;
+
+//written per draw from the ring buffer
+layout(std140) uniform ModelBlock
+{
+	mat4 model;
+};
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 Normal;
+
+void main()
+{
+	Normal = mat3(model)*normal;
+	gl_Position = projection*view*model*vec4(vertex, 1.0);
+}
+)"
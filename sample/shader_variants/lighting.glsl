@@ -0,0 +1,39 @@
+R"(
+struct Light{
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+	vec3 position;
+};
+
+struct Material{
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+	float shininess;
+};
+
+struct Attenuation{
+	float constant;
+	float linear;
+	float quadratic;
+};
+
+vec4 phong(Light light, Material material, vec3 N, vec3 P, vec3 L)
+{
+	//ambient
+	vec4 ambient = light.ambient*material.ambient;
+	//diffuse
+	float diffuseLighting = max(dot(N, normalize(L-P)), 0);
+	vec4 diffuse = light.diffuse*diffuseLighting*material.diffuse;
+	//specular
+	vec3 H = normalize(normalize(L-P)+normalize(-P));
+	float specularLighting = pow(max(dot(H, N),0), material.shininess);
+	if(diffuseLighting <= 0.0)
+	{
+		specularLighting = 0.0;
+	}
+	vec4 specular = specularLighting*light.specular*material.specular;
+	return ambient + diffuse + specular;
+}
+)"
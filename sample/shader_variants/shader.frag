@@ -0,0 +1,30 @@
+R"(
+#version 120
+#include "lighting.glsl"
+
+varying vec3 Normal;
+varying vec3 Vertex;
+varying vec2 Texcrd;
+
+varying mat4 Model;
+varying mat4 View;
+varying mat4 Projection;
+
+uniform Light light;
+uniform Material material;
+#ifdef USE_ATTENUATION
+uniform Attenuation attenuation;
+#endif
+
+void main()
+{
+	vec3 N = normalize(mat3(View*Model)*Normal);
+	vec3 P = (View*Model*vec4(Vertex, 1.0)).xyz;
+	vec3 L = (View*vec4(light.position, 1.0)).xyz;
+	vec4 color = phong(light, material, N, P, L);
+#ifdef USE_ATTENUATION
+	color *= 1.0/(attenuation.constant+attenuation.linear*length(L-P)+attenuation.quadratic*length(L-P)*length(L-P));
+#endif
+	gl_FragColor = color;
+}
+)"
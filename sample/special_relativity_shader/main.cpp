@@ -13,13 +13,6 @@ int threadfunction(void* data)
 	return 0;
 }
 
-const std::string vshader_source = 
-#include "shader.vert"
-;
-const std::string fshader_source = 
-#include "shader.frag"
-;
-
 //for skymap texture
 
 const std::string vshader_sky =
@@ -81,6 +74,36 @@ Uint32 tick = 0;
 
 float light_speed = 100.0f;
 
+//uniform handles used every frame (looked up once after link)
+struct UniformHandles
+{
+	jikoLib::GLLib::UniformHandle model, view, projection, beta, diminish, textureobj;
+	jikoLib::GLLib::UniformHandle light_ambient, light_diffuse, light_specular, light_position;
+	jikoLib::GLLib::UniformHandle material_ambient, material_diffuse, material_specular, material_shininess;
+	jikoLib::GLLib::UniformHandle attenuation_constant, attenuation_linear, attenuation_quadratic;
+
+	void lookup(const jikoLib::GLLib::ShaderProgram &prog)
+	{
+		model = prog.getUniformHandle("model");
+		view = prog.getUniformHandle("view");
+		projection = prog.getUniformHandle("projection");
+		beta = prog.getUniformHandle("beta");
+		diminish = prog.getUniformHandle("diminish");
+		textureobj = prog.getUniformHandle("textureobj");
+		light_ambient = prog.getUniformHandle("light.ambient");
+		light_diffuse = prog.getUniformHandle("light.diffuse");
+		light_specular = prog.getUniformHandle("light.specular");
+		light_position = prog.getUniformHandle("light.position");
+		material_ambient = prog.getUniformHandle("material.ambient");
+		material_diffuse = prog.getUniformHandle("material.diffuse");
+		material_specular = prog.getUniformHandle("material.specular");
+		material_shininess = prog.getUniformHandle("material.shininess");
+		attenuation_constant = prog.getUniformHandle("attenuation.constant");
+		attenuation_linear = prog.getUniformHandle("attenuation.linear");
+		attenuation_quadratic = prog.getUniformHandle("attenuation.quadratic");
+	}
+};
+
 
 int main(int argc, char* argv[])
 {
@@ -116,15 +139,21 @@ int main(int argc, char* argv[])
 
 	SDL_GL_MakeCurrent(window, context);
 
-	VShader vshader;
-	FShader fshader;
+	//shader.vert and shader.frag are read at runtime and reloaded when edited
+	//usage: ./a.out [directory of shader files]
+	const std::string shader_dir = (argc > 1) ? argv[1] : "src";
 
-	ShaderProgram program;
-
-	vshader << vshader_source;
-	fshader << fshader_source;
+	ShaderReloader<> reloader;
+	//the files are wrapped in R"( )" like the shaders embedded in the other samples
+	reloader.getPreprocessor().setUnwrapRawString(true);
+	reloader.addStage<VertexShader>(shader_dir + "/shader.vert");
+	reloader.addStage<FragmentShader>(shader_dir + "/shader.frag");
+	if(!reloader.build())
+	{
+		std::cerr << "cannot build shader in " << shader_dir << std::endl;
+	}
 
-	program << vshader << fshader << link_these();
+	ShaderProgram& program = reloader.get();
 
 	ShaderProgram skyprogram;
 
@@ -135,6 +164,15 @@ int main(int argc, char* argv[])
 	fshader1 << fshader_sky;
 
 	skyprogram << vshader1 << fshader1 << link_these();
+
+	UniformHandles uniform;
+	uniform.lookup(program);
+
+	//handles belong to a program. look them up again after reload
+	reloader.setOnReload([&](ShaderProgram &prog)
+			{
+				uniform.lookup(prog);
+			});
 	
 
 	//
@@ -153,21 +191,28 @@ int main(int argc, char* argv[])
 	texture.setParameter<Wrap_S<GL_REPEAT>, Wrap_T<GL_REPEAT>, Wrap_R<GL_REPEAT>, Mag_Filter<GL_NEAREST>, Min_Filter<GL_NEAREST>>();
 	
 	//floor mesh
+	//every tile shares one quad in the arena, only the model matrix differs
 	
-	std::vector<Mesh3D> floor_mesh_arr;
+	GeometryArena<VertexFormatPNT, GLushort> floor_arena(4, 6);
+	GeometrySlice floor_slice = floor_arena.addIndexed(floor_index, 6, 4, &floorvertex[0][0], &floornormal[0][0], &floortexcrd[0][0]);
+
+	std::vector<ArenaMesh3D> floor_mesh_arr;
 
 	for(float z = -200; z<200; z+=10)
 	{
 		for(float x = -200; x<200; x+=10)
 		{
-			Mesh3D floor_mesh;
-			floor_mesh.copyData(floorvertex, floornormal, floortexcrd);
-			floor_mesh.copyIndex(floor_index);
+			ArenaMesh3D floor_mesh(floor_slice);
 			floor_mesh.setPos(glm::vec3(x, 0.0f, z));
 			floor_mesh_arr.push_back(floor_mesh);
 		}
 	}
 
+#ifdef GLLIB_USE_POOL_ALLOCATOR
+	std::cout << "glGen* calls for floor: "
+		<< GLPoolAllocator<Alloc_VertexBuffer>::getNumGLCalls() + GLPoolAllocator<Alloc_VertexArray>::getNumGLCalls() << std::endl;
+#endif
+
 	//cubes
 	
 	std::vector<Mesh3D> cube_arr;
@@ -247,6 +292,7 @@ int main(int argc, char* argv[])
 
 	Mesh3D sphere_mesh;
 	sphere_mesh.copyData(sp_helper.getVertex(), sp_helper.getNormal(), sp_helper.getTexcrd(), sp_helper.getNumVertex());
+	sphere_mesh.copyIndexNarrowed(sp_helper.getIndex(), sp_helper.getNumIndex());
 	sphere_mesh.setPos(glm::vec3(-100.0f, 50.0f, 0.0f));
 	sphere_arr.push_back(sphere_mesh);
 	sphere_mesh.setPos(glm::vec3(0.0f, 50.0f, 0.0f));
@@ -287,12 +333,19 @@ int main(int argc, char* argv[])
 
 
 
+	//leave objects bound after use. next bind of the same object is skipped
+	BindState::setLazyUnbind(true);
+	unsigned int frame_count = 0;
+
 	bool quit = false;
 	SDL_Event e;
 	//	SDL_WaitThread(threadID, NULL);
 
 	while( !quit )
 	{
+		//swap in edited shaders (never blocks)
+		reloader.update();
+
 		//Handle events on queue
 		while( SDL_PollEvent( &e ) != 0 )
 		{
@@ -389,56 +442,57 @@ int main(int argc, char* argv[])
 		camera.setDrct(glm::vec3(curr_x, curr_y, curr_z)+glm::vec3(sin(curr_theta)*sin(curr_phi), cos(curr_theta), sin(curr_theta)*cos(curr_phi)));
 		camera.setAspect(width, height);
 		camera.setPos(glm::vec3(curr_x, curr_y, curr_z));
-		program.setUniformMatrixXtv("view", glm::value_ptr(camera.getViewMatrix()), 1, 4);
-		program.setUniformMatrixXtv("projection", glm::value_ptr(camera.getProjectionMatrix()), 1, 4);
+		program.setUniformMatrixXtv(uniform.view, glm::value_ptr(camera.getViewMatrix()), 1, 4);
+		program.setUniformMatrixXtv(uniform.projection, glm::value_ptr(camera.getProjectionMatrix()), 1, 4);
 
 		// TODO: render all shapes
 
 		//light speed
 		if(flag_l)
 		{
-			program.setUniformXt("beta", velocity/light_speed);
+			program.setUniformXt(uniform.beta, velocity/light_speed);
 			std::cout << "v/c = " << velocity/light_speed << std::endl;
 		}
 		else
 		{
-			program.setUniformXt("beta", 0.0f);
+			program.setUniformXt(uniform.beta, 0.0f);
 			std::cout << "v/c = OFF"  << std::endl;
 		}
 
 		// light setting
 
-		program.setUniformXt("light.ambient", 0.75f, 0.75f, 0.75f, 1.0f);
-		program.setUniformXt("light.diffuse", 0.7f, 0.7f, 0.7f, 1.0f);
-		program.setUniformXt("light.specular", 1.0f, 1.0f, 1.0f, 1.0f);
-		program.setUniformXt("light.position", curr_x, curr_y, curr_z);
-		program.setUniformXt("diminish", 1.0f);
+		program.setUniformXt(uniform.light_ambient, 0.75f, 0.75f, 0.75f, 1.0f);
+		program.setUniformXt(uniform.light_diffuse, 0.7f, 0.7f, 0.7f, 1.0f);
+		program.setUniformXt(uniform.light_specular, 1.0f, 1.0f, 1.0f, 1.0f);
+		program.setUniformXt(uniform.light_position, curr_x, curr_y, curr_z);
+		program.setUniformXt(uniform.diminish, 1.0f);
 
 		//floor with texture
-		program.setUniformXt("textureobj", 0);
+		program.setUniformXt(uniform.textureobj, 0);
 		
-		program.setUniformXt("material.ambient", 0.3f, 0.25f, 0.4f, 1.0f);
-		program.setUniformXt("material.diffuse", 0.75f, 0.0f, 1.0f, 1.0f);
-		program.setUniformXt("material.specular", 1.0f, 1.0f, 1.0f, 1.0f);
-		program.setUniformXt("material.shininess", 32.0f);
+		program.setUniformXt(uniform.material_ambient, 0.3f, 0.25f, 0.4f, 1.0f);
+		program.setUniformXt(uniform.material_diffuse, 0.75f, 0.0f, 1.0f, 1.0f);
+		program.setUniformXt(uniform.material_specular, 1.0f, 1.0f, 1.0f, 1.0f);
+		program.setUniformXt(uniform.material_shininess, 32.0f);
 
-		program.setUniformXt("attenuation.constant", 0.00f);
-		program.setUniformXt("attenuation.linear", 0.2f);
-		program.setUniformXt("attenuation.quadratic", 0.0f);
+		program.setUniformXt(uniform.attenuation_constant, 0.00f);
+		program.setUniformXt(uniform.attenuation_linear, 0.2f);
+		program.setUniformXt(uniform.attenuation_quadratic, 0.0f);
 
+		//once for all tiles (attribute locations may change on reload)
+		obj.connectAttrib(program, floor_arena, "vertex", "normal", "texcrd");
 		for(auto& floor_mesh : floor_mesh_arr)
 		{
-			obj.connectAttrib(program, floor_mesh, "vertex", "normal", "texcrd");
-			program.setUniformMatrixXtv("model", glm::value_ptr(floor_mesh.getModelMatrix()), 1, 4);
+			program.setUniformMatrixXtv(uniform.model, glm::value_ptr(floor_mesh.getModelMatrix()), 1, 4);
 			texture3.bind(0);
-			obj.draw(floor_mesh, program);
+			obj.draw(floor_arena, floor_mesh, program);
 			texture3.unbind();
 		}
 
 		for(auto& cube_mesh : cube_arr)
 		{
 			obj.connectAttrib(program, cube_mesh, "vertex", "normal", "texcrd");
-			program.setUniformMatrixXtv("model", glm::value_ptr(cube_mesh.getModelMatrix()), 1, 4);
+			program.setUniformMatrixXtv(uniform.model, glm::value_ptr(cube_mesh.getModelMatrix()), 1, 4);
 			texture2.bind(0);
 			obj.draw(cube_mesh, program);
 			texture2.unbind();
@@ -447,7 +501,7 @@ int main(int argc, char* argv[])
 		for(auto& sphere_mesh : sphere_arr)
 		{
 			obj.connectAttrib(program, sphere_mesh, "vertex", "normal", "texcrd");
-			program.setUniformMatrixXtv("model", glm::value_ptr(sphere_mesh.getModelMatrix()), 1, 4);
+			program.setUniformMatrixXtv(uniform.model, glm::value_ptr(sphere_mesh.getModelMatrix()), 1, 4);
 			texture.bind(0);
 			obj.draw(sphere_mesh, program);
 			texture.unbind();
@@ -469,10 +523,38 @@ int main(int argc, char* argv[])
 
 
 		SDL_GL_SwapWindow( window );
+
+		//delete objects retired by frames the GPU has finished
+		RetireQueue::endFrame();
+		MemoryStats::endFrame();
+#ifdef GLLIB_USE_POOL_ALLOCATOR
+		GLPoolAllocator<Alloc_VertexBuffer>::flush();
+		GLPoolAllocator<Alloc_VertexArray>::flush();
+#endif
+
+		//redundant bind/unbind eliminated by BindState
+		if(++frame_count % 300 == 0)
+		{
+			std::cout << "binds issued: " << BindState::getNumIssued() << ", skipped: " << BindState::getNumSkipped() << std::endl;
+			BindState::resetCounter();
+			std::cout << "GPU memory: " << MemoryStats::getLiveBytes()/1024 << " KiB (peak " << MemoryStats::getPeakBytes()/1024
+				<< " KiB, buffers " << MemoryStats::getLiveBytes<Alloc_VertexBuffer>()/1024
+				<< " KiB, textures " << MemoryStats::getLiveBytes<Alloc_Texture>()/1024 << " KiB)" << std::endl;
+		}
 	}
 
 	//	obj << End();
 
+#ifdef GLLIB_USE_POOL_ALLOCATOR
+	//delete pooled names while the context is alive
+	floor_mesh_arr.clear();
+	cube_arr.clear();
+	sphere_arr.clear();
+	GLPoolAllocator<Alloc_VertexBuffer>::clear();
+	GLPoolAllocator<Alloc_VertexArray>::clear();
+#endif
+	RetireQueue::finish();
+
 	SDL_GL_DeleteContext(context);
 	SDL_DestroyWindow(window);
 	SDL_Quit();
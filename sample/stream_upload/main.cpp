@@ -0,0 +1,149 @@
+#include "../include/gllib/gl_all.h"
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_opengl.h>
+
+jikoLib::GLLib::GLObject obj;
+
+const std::string vshader_source = 
+#include "shader.vert"
+;
+const std::string fshader_source = 
+#include "shader.frag"
+;
+
+//points rewritten every frame (3 floats each)
+const std::size_t NUM_POINT = 1 << 18;
+const int NUM_FRAME = 300;
+
+enum Strategy
+{
+	SUB_DATA,     //glBufferSubData into the store the last draw reads (implicit sync)
+	ORPHAN,       //glBufferData(NULL) + glBufferSubData
+	MAP_INVALIDATE //glMapBufferRange(GL_MAP_INVALIDATE_BUFFER_BIT)
+};
+
+//point sets cycled through the frames. generated before timing
+const int NUM_SET = 4;
+
+std::vector<std::vector<GLfloat>> makePointSets()
+{
+	std::vector<std::vector<GLfloat>> sets(NUM_SET, std::vector<GLfloat>(NUM_POINT*3));
+	for(int set=0; set<NUM_SET; set++)
+	{
+		for(std::size_t i=0; i<NUM_POINT; i++)
+		{
+			const float t = 0.001f*i + 0.05f*set;
+			sets[set][3*i+0] = std::sin(t);
+			sets[set][3*i+1] = std::cos(1.3f*t);
+			sets[set][3*i+2] = 0.0f;
+		}
+	}
+	return sets;
+}
+
+//upload and draw NUM_FRAME frames. returns upload throughput in MB/s
+//only the upload and the draw call are timed (clear and swap are not)
+template<typename UsageType>
+double run(SDL_Window* window, jikoLib::GLLib::ShaderProgram &program, Strategy strategy, const std::vector<std::vector<GLfloat>> &sets)
+{
+	using namespace jikoLib::GLLib;
+
+	VertexBuffer<ArrayBuffer, UsageType> vbo;
+	VAO vao;
+	vbo.copyData(sets[0].data(), NUM_POINT, 3);
+	obj.connectAttrib(program, vbo, vao, "vertex");
+	glFinish();
+
+	std::chrono::steady_clock::duration elapsed(0);
+	for(int frame=0; frame<NUM_FRAME; frame++)
+	{
+		const GLfloat* points = sets[frame % NUM_SET].data();
+		obj.clear(GL_COLOR_BUFFER_BIT);
+
+		auto start = std::chrono::steady_clock::now();
+		switch(strategy)
+		{
+			case SUB_DATA:
+				vbo.subData(0, points, NUM_POINT);
+				break;
+			case ORPHAN:
+				vbo.streamData(points, NUM_POINT, 3);
+				break;
+			case MAP_INVALIDATE:
+				vbo.streamDataMapped(points, NUM_POINT, 3);
+				break;
+		}
+		obj.draw<rm_Points>(vao, program, vbo);
+		elapsed += std::chrono::steady_clock::now() - start;
+
+		SDL_GL_SwapWindow(window);
+	}
+	//the last uploads may still be in flight
+	auto start = std::chrono::steady_clock::now();
+	glFinish();
+	elapsed += std::chrono::steady_clock::now() - start;
+
+	const double sec = std::chrono::duration<double>(elapsed).count();
+	const double mbytes = static_cast<double>(NUM_POINT*3*sizeof(GLfloat))*NUM_FRAME/(1024.0*1024.0);
+	return mbytes/sec;
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace jikoLib::GLLib;
+
+	if(SDL_Init(SDL_INIT_EVERYTHING) < 0)
+	{
+		std::cerr << "Cannot Initialize SDL!: " << SDL_GetError() << std::endl;
+		return -1;
+	}
+
+	SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 5);
+	SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 16);
+	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1); 
+
+	SDL_Window* window = SDL_CreateWindow("SDL_Window", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 400, 300, SDL_WINDOW_OPENGL);
+	if(window == NULL)
+	{
+		std::cerr << "Window could not be created!: " << SDL_GetError() << std::endl;
+	}
+
+	SDL_GLContext context;
+
+	context = SDL_GL_CreateContext(window);
+
+	obj << Begin();
+
+	SDL_GL_MakeCurrent(window, context);
+
+	//do not let vsync hide the upload cost
+	SDL_GL_SetSwapInterval(0);
+
+	ShaderProgram program;
+	VShader vshader;
+	FShader fshader;
+	vshader << vshader_source;
+	fshader << fshader_source;
+	program << vshader << fshader << link_these();
+
+	const auto sets = makePointSets();
+	const double mb_subdata = run<DynamicDraw>(window, program, SUB_DATA, sets);
+	const double mb_orphan = run<StreamDraw>(window, program, ORPHAN, sets);
+	const double mb_map = run<StreamDraw>(window, program, MAP_INVALIDATE, sets);
+
+	std::cout << NUM_FRAME << " frames, " << NUM_POINT*3*sizeof(GLfloat)/1024 << " KiB per frame" << std::endl;
+	std::cout << "subData (DynamicDraw)       : " << mb_subdata << " MB/s" << std::endl;
+	std::cout << "orphan (StreamDraw)         : " << mb_orphan << " MB/s" << std::endl;
+	std::cout << "map invalidate (StreamDraw) : " << mb_map << " MB/s" << std::endl;
+
+	SDL_GL_DeleteContext(context);
+	SDL_DestroyWindow(window);
+	SDL_Quit();
+
+	return 0;
+}
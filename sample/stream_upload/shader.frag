@@ -0,0 +1,8 @@
+R"(
+#version 120
+
+void main()
+{
+	gl_FragColor = vec4(1.0, 1.0, 1.0, 1.0);
+}
+)"
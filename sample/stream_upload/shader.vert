@@ -0,0 +1,11 @@
+R"(
+#version 120
+
+attribute vec3 vertex;
+
+void main()
+{
+	gl_PointSize = 1.0;
+	gl_Position = vec4(vertex, 1.0);
+}
+)"